@@ -0,0 +1,384 @@
+// Assembles generated programs of increasing size and reports the time
+// spent lexing, in pass 0, in pass 1 and writing the object file.
+//
+//   assembler_bench [--json <file>] [--reps N] [--single-pass] [generator options]
+//   assembler_bench --emit [generator options] > program.s
+//
+// Generator options: --sections N --lines N --labels N --words N
+// --equs N --externs N --symbols PERCENT --seed N. With --sections the
+// benchmark runs that one size, otherwise 1, 4, 16 and 64 sections.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "assembler.hpp"
+#include "mapped_file.hpp"
+#include "version.hpp"
+
+namespace
+{
+
+// Program shape, every section stays within the 16 bit object format
+// limits (section size, relocation and symbol table sizes)
+struct GenParams
+{
+    unsigned sections = 16;
+    unsigned lines = 2000; // instruction lines per section
+    unsigned labels = 200; // labels per section, 4 of them global
+    unsigned words = 64; // .word jump table entries per section
+    unsigned equs = 64;
+    unsigned externs = 16;
+    unsigned symbols = 60; // percent of operands that are symbols
+    std::uint64_t seed = 1;
+};
+
+// splitmix64, the same sequence on every platform
+class Random
+{
+public:
+    explicit Random(std::uint64_t seed) : state_(seed) {}
+
+    std::uint64_t next()
+    {
+        std::uint64_t z = (state_ += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+    unsigned below(unsigned n) { return (unsigned)(next() % n); }
+    bool percent(unsigned p) { return below(100) < p; }
+
+private:
+    std::uint64_t state_;
+};
+
+const char *const REGS[] = { "r0", "r1", "r2", "r3", "r4", "r5", "r6", "r7", "sp", "psw" };
+
+class Generator
+{
+public:
+    explicit Generator(const GenParams& params) : params_(params), random_(params.seed) {}
+
+    std::string program()
+    {
+        out_.clear();
+
+        out_ += ".extern ";
+        for (unsigned i = 0; i < params_.externs; ++i)
+            out_ += (i ? ", x" : "x") + std::to_string(i);
+        out_ += "\n.global ";
+        for (unsigned s = 0; s < params_.sections; ++s)
+            for (unsigned l = 0; l < 4 && l < params_.labels; ++l)
+                out_ += (s || l ? ", " : "") + label(s, l);
+        out_ += '\n';
+
+        for (unsigned i = 0; i < params_.equs; ++i) // half of them defined after use
+            if (i % 2 == 0)
+                out_ += ".equ e" + std::to_string(i) + ", " + std::to_string(random_.below(0x10000)) + '\n';
+
+        for (unsigned s = 0; s < params_.sections; ++s)
+            section(s);
+
+        for (unsigned i = 1; i < params_.equs; i += 2)
+            out_ += ".equ e" + std::to_string(i) + ", " + std::to_string(random_.below(0x10000)) + '\n';
+        out_ += ".end\n";
+
+        return std::move(out_);
+    }
+
+private:
+    static std::string label(unsigned section, unsigned index)
+    {
+        return "l" + std::to_string(section) + "_" + std::to_string(index);
+    }
+
+    void section(unsigned s)
+    {
+        out_ += ".section s" + std::to_string(s) + '\n';
+
+        unsigned nextLabel = 0;
+        for (unsigned i = 0; i < params_.lines; ++i) {
+            if (nextLabel < params_.labels && random_.below(params_.lines) < params_.labels)
+                out_ += label(s, nextLabel++) + ":\n";
+            if (random_.percent(2))
+                out_ += "    .skip " + std::to_string(random_.below(16)) + '\n';
+            instruction();
+        }
+        for (; nextLabel < params_.labels; ++nextLabel)
+            out_ += label(s, nextLabel) + ":\n";
+        out_ += "    halt\n";
+
+        // jump table
+        for (unsigned i = 0; i < params_.words; ++i) {
+            out_ += i % 8 ? ", " : "    .word ";
+            out_ += symbolOrLiteral();
+            if (i % 8 == 7 || i + 1 == params_.words)
+                out_ += '\n';
+        }
+    }
+
+    // Any label, extern or .equ symbol
+    std::string symbol()
+    {
+        unsigned kind = random_.below(8);
+        if (kind == 0 && params_.externs)
+            return "x" + std::to_string(random_.below(params_.externs));
+        if (kind == 1 && params_.equs)
+            return "e" + std::to_string(random_.below(params_.equs));
+        if (!params_.labels)
+            return "0";
+        return label(random_.below(params_.sections), random_.below(params_.labels));
+    }
+    std::string symbolOrLiteral()
+    {
+        if (random_.percent(params_.symbols))
+            return symbol();
+        unsigned value = random_.below(0x10000);
+        if (random_.percent(50))
+            return std::to_string(value);
+        char hex[8];
+        std::snprintf(hex, sizeof(hex), "0x%X", value);
+        return hex;
+    }
+    std::string reg() { return REGS[random_.below(sizeof(REGS) / sizeof(REGS[0]))]; }
+    std::string pcRelative() { return "%" + label(random_.below(params_.sections), random_.below(params_.labels)); }
+
+    // One operand in an addressing mode of mask, in data or jump syntax
+    std::string operand(addr_mode_type mask, bool jmpSyntax)
+    {
+        const addr_mode_type modes[] = { IMMED, REGDIR, REGDIR_OFFSET, REGIND, REGIND_OFFSET, MEMDIR };
+        addr_mode_type mode;
+        do
+            mode = modes[random_.below(6)];
+        while (!(mask & mode));
+
+        const char *star = jmpSyntax ? "*" : "";
+        switch (mode) {
+        case IMMED:
+            return (jmpSyntax ? "" : "$") + symbolOrLiteral();
+        case MEMDIR:
+            return star + symbolOrLiteral();
+        case REGDIR:
+            return star + reg();
+        case REGIND:
+            return star + ("[" + reg() + "]");
+        case REGIND_OFFSET:
+            if (!jmpSyntax && params_.labels && random_.percent(25))
+                return pcRelative();
+            return star + ("[" + reg() + " + " + symbolOrLiteral() + "]");
+        default: // REGDIR_OFFSET is only written as %<symbol> in jump syntax
+            if (jmpSyntax && params_.labels)
+                return pcRelative();
+            return star + reg();
+        }
+    }
+
+    void instruction()
+    {
+        const StaticMapEntry<InstrInfo> &instr = INSTRUCTIONS.begin()[random_.below(INSTRUCTIONS.size())];
+        const InstrInfo &info = instr.value;
+        if (info.opCode == 0x00u && random_.percent(95)) // keep halt rare
+            return instruction();
+
+        out_ += "    ";
+        out_ += instr.key;
+        for (ubyte i = 0; i < info.numArgs; ++i) {
+            out_ += i ? ", " : " ";
+            out_ += operand(info.argAddrModes[i], info.jmpSyntax);
+        }
+        out_ += '\n';
+    }
+
+    GenParams params_;
+    Random random_;
+    std::string out_;
+};
+
+struct Result
+{
+    unsigned sections;
+    std::size_t lines;
+    std::size_t bytes;
+    double lex; // seconds, median of the repetitions
+    double phases[NUM_PHASES];
+};
+
+double median(std::vector<double> values)
+{
+    std::sort(values.begin(), values.end());
+    return values[values.size() / 2];
+}
+
+// Lexer alone over the input, with a throwaway assembler for locations and atoms
+double lexSeconds(const MappedFile& input)
+{
+    Assembler assembler;
+    yy::Lexer lexer;
+    const int eof = yy::Parser::make_YYEOF(assembler.getLocation()).type_get();
+
+    auto start = std::chrono::steady_clock::now();
+    lexer.reset(input.data(), input.size());
+    while (lexer.get_token(assembler).type_get() != eof)
+        ;
+    auto end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double>(end - start).count();
+}
+
+bool measure(const GenParams& params, const AssemblerOptions& options, unsigned reps,
+             const std::string& inFilename, const std::string& outFilename, Result& result)
+{
+    std::string program = Generator(params).program();
+    std::ofstream(inFilename, std::ios::binary) << program;
+
+    result.sections = params.sections;
+    result.bytes = program.size();
+    result.lines = std::count(program.begin(), program.end(), '\n');
+
+    MappedFile input;
+    if (!input.open(inFilename)) {
+        std::cerr << "Cannot open file: " << inFilename << "\n";
+        return false;
+    }
+
+    Assembler assembler(options);
+    std::vector<double> lex, phases[NUM_PHASES];
+    for (unsigned r = 0; r < reps; ++r) {
+        if (assembler.run(inFilename, outFilename) != AE_OK)
+            return false;
+        for (int p = 0; p < NUM_PHASES; ++p)
+            phases[p].push_back(assembler.stats().wall[p]);
+        lex.push_back(lexSeconds(input));
+    }
+
+    result.lex = median(lex);
+    for (int p = 0; p < NUM_PHASES; ++p)
+        result.phases[p] = median(phases[p]);
+    return true;
+}
+
+void printJson(std::ostream& out, const std::vector<Result>& results, const AssemblerOptions& options,
+               unsigned reps)
+{
+    out << "{\n  \"version\": \"" << ASSEMBLER_VERSION << "\",\n"
+        << "  \"single_pass\": " << (options.singlePass ? "true" : "false") << ",\n"
+        << "  \"reps\": " << reps << ",\n  \"results\": [";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const Result &r = results[i];
+        double total = 0;
+        for (double seconds : r.phases)
+            total += seconds;
+
+        out << (i ? ",\n" : "\n") << "    { \"sections\": " << r.sections << ", \"lines\": " << r.lines
+            << ", \"bytes\": " << r.bytes << ", \"lex_s\": " << r.lex;
+        for (int p = 0; p < NUM_PHASES; ++p)
+            out << ", \"" << PHASE_NAMES[p] << "_s\": " << r.phases[p];
+        out << ", \"total_s\": " << total
+            << ", \"lex_mb_per_s\": " << r.bytes / r.lex / 1e6
+            << ", \"mb_per_s\": " << r.bytes / total / 1e6
+            << ", \"lines_per_s\": " << r.lines / total << " }";
+    }
+    out << "\n  ]\n}\n";
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    GenParams params;
+    AssemblerOptions options;
+    std::vector<unsigned> sizes = { 1, 4, 16, 64 };
+    std::string jsonFilename;
+    unsigned reps = 5;
+    bool emit = false;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        // value of a numeric option
+        auto number = [&]() { return i + 1 < argc ? std::strtoul(argv[++i], nullptr, 10) : 0ul; };
+
+        if (arg == "--emit")
+            emit = true;
+        else if (arg == "--single-pass")
+            options.singlePass = true;
+        else if (arg == "--json" && i + 1 < argc)
+            jsonFilename = argv[++i];
+        else if (arg == "--reps")
+            reps = std::max(1ul, number());
+        else if (arg == "--sections") {
+            params.sections = std::max(1ul, number());
+            sizes = { params.sections };
+        } else if (arg == "--lines")
+            params.lines = number();
+        else if (arg == "--labels")
+            params.labels = number();
+        else if (arg == "--words")
+            params.words = number();
+        else if (arg == "--equs")
+            params.equs = number();
+        else if (arg == "--externs")
+            params.externs = number();
+        else if (arg == "--symbols")
+            params.symbols = std::min(100ul, number());
+        else if (arg == "--seed")
+            params.seed = number();
+        else {
+            std::cerr << "Unknown option: " << arg << "\n";
+            return 1;
+        }
+    }
+
+    if (emit) {
+        std::cout << Generator(params).program();
+        return 0;
+    }
+
+    std::filesystem::path tmp = std::filesystem::temp_directory_path();
+    std::string base = "assembler_bench." + std::to_string(getpid());
+    std::string inFilename = (tmp / (base + ".s")).string();
+    std::string outFilename = (tmp / (base + ".o")).string();
+
+    std::vector<Result> results;
+    std::printf("%8s %9s %10s %9s %9s %9s %9s %9s %11s\n", "sections", "lines", "bytes",
+                "lex ms", "pass0 ms", "pass1 ms", "write ms", "MB/s", "lines/s");
+    for (unsigned sections : sizes) {
+        params.sections = sections;
+        Result result;
+        if (!measure(params, options, reps, inFilename, outFilename, result)) {
+            std::remove(inFilename.c_str());
+            return 1;
+        }
+        results.push_back(result);
+
+        double total = result.phases[PHASE_PARSE] + result.phases[PHASE_ENCODE] + result.phases[PHASE_WRITE];
+        std::printf("%8u %9zu %10zu %9.2f %9.2f %9.2f %9.2f %9.1f %11.0f\n", sections, result.lines,
+                    result.bytes, result.lex * 1e3, result.phases[PHASE_PARSE] * 1e3,
+                    result.phases[PHASE_ENCODE] * 1e3, result.phases[PHASE_WRITE] * 1e3,
+                    result.bytes / total / 1e6, result.lines / total);
+    }
+    std::remove(inFilename.c_str());
+    std::remove(outFilename.c_str());
+
+    if (jsonFilename == "-")
+        printJson(std::cout, results, options, reps);
+    else if (!jsonFilename.empty()) {
+        std::ofstream json(jsonFilename);
+        printJson(json, results, options, reps);
+        if (!json) {
+            std::cerr << "Cannot write file: " << jsonFilename << "\n";
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,82 @@
+// Compares the constexpr keyword tables against the std::unordered_map
+// tables they replaced, using the lookups done by instrFirstPass,
+// dirFirstPass and instrArgRegDir.
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "instruction.hpp"
+#include "directive.hpp"
+#include "register.hpp"
+
+namespace
+{
+
+const std::size_t ITERATIONS = 2000000;
+
+template<typename T, std::size_t N>
+std::unordered_map<std::string, T> legacyMap(const StaticMap<T, N>& table)
+{
+    std::unordered_map<std::string, T> map;
+    for (const StaticMapEntry<T>& entry : table)
+        map.emplace(std::string(entry.key), entry.value);
+    return map;
+}
+
+template<typename T, std::size_t N>
+std::vector<std::string_view> keys(const StaticMap<T, N>& table)
+{
+    std::vector<std::string_view> keys;
+    for (const StaticMapEntry<T>& entry : table)
+        keys.push_back(entry.key);
+    keys.push_back("bogus"); // exercise the miss path too
+    return keys;
+}
+
+template<typename F>
+double nsPerLookup(const std::vector<std::string_view>& keys, F lookup)
+{
+    std::size_t hits = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < ITERATIONS; ++i)
+        hits += lookup(keys[i % keys.size()]);
+    auto end = std::chrono::steady_clock::now();
+
+    // keep the loop from being optimized away
+    if (hits == ITERATIONS + 1)
+        std::puts("");
+
+    return std::chrono::duration<double, std::nano>(end - start).count() / ITERATIONS;
+}
+
+template<typename T, std::size_t N>
+void bench(const char *name, const StaticMap<T, N>& table)
+{
+    const std::unordered_map<std::string, T> legacy = legacyMap(table);
+    const std::vector<std::string_view> names = keys(table);
+
+    double legacyNs = nsPerLookup(names, [&](std::string_view key) {
+        return legacy.find(std::string(key)) != legacy.end();
+    });
+    double staticNs = nsPerLookup(names, [&](std::string_view key) {
+        return table.find(key) != nullptr;
+    });
+
+    std::printf("%-16s unordered_map %6.2f ns   static_map %6.2f ns   %5.2fx\n",
+                name, legacyNs, staticNs, legacyNs / staticNs);
+}
+
+}
+
+int main()
+{
+    bench("instrFirstPass", INSTRUCTIONS);
+    bench("dirFirstPass", DIRECTIVES);
+    bench("instrArgRegDir", REGISTERS);
+
+    return 0;
+}
@@ -0,0 +1,10 @@
+#ifndef ALLOC_STATS_H
+#define ALLOC_STATS_H
+
+#include <cstddef>
+
+// Number of heap allocations (operator new calls) since program start
+std::size_t heapAllocationCount();
+void countHeapAllocation(); // called by the replacement operator new
+
+#endif
@@ -0,0 +1,23 @@
+#ifndef ASSEMBLE_H
+#define ASSEMBLE_H
+
+#include <string_view>
+#include <vector>
+
+#include "assembler.hpp"
+
+struct AssembleResult
+{
+    int status = AE_OK; // AssemblerExitCode
+    ObjectBuffer object; // empty on errors
+    std::vector<Diagnostic> diagnostics;
+
+    bool ok() const { return status == AE_OK; }
+};
+
+// Assemble one source held in memory. Each call sets up a fresh Assembler;
+// for many small sources keep one Assembler and call its assemble() instead,
+// which reuses the buffers between runs.
+AssembleResult assemble(std::string_view source, const AssemblerOptions& options = AssemblerOptions());
+
+#endif
@@ -1,9 +1,14 @@
 #ifndef ASSEMBLER_H
 #define ASSEMBLER_H
 
-#include <fstream>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <memory_resource>
+#include <ostream>
 #include <vector>
 #include <string>
+#include <string_view>
 
 #include "lexer.hpp"
 #include "parser.hpp"
@@ -14,6 +19,16 @@
 #include "symbol.hpp"
 #include "types.hpp"
 #include "obj.hpp"
+#include "ir.hpp"
+#include "expr.hpp"
+#include "macro.hpp"
+#include "atom.hpp"
+#include "mapped_file.hpp"
+#include "header_cache.hpp"
+#include "object_cache.hpp"
+#include "output_file.hpp"
+#include "stats.hpp"
+#include "diagnostic.hpp"
 
 enum AssemblerExitCode: int
 {
@@ -24,14 +39,121 @@ enum AssemblerExitCode: int
     AE_FILE, // file errors (cannot open file, no file provided...)
 };
 
+struct AssemblerOptions
+{
+    bool singlePass = false; // encode while parsing, patch symbol references at .end
+    unsigned sectionJobs = 1; // workers encoding sections in the second pass
+    std::string cacheDir; // object cache directory, empty to disable
+    bool packedRelocations = false; // sorted, delta and varint encoded relocation sections
+    bool zeroFill = false; // don't store trailing .skip bytes of data sections
+    bool optimize = false; // peephole pass over the IR (two pass mode only)
+    StatsFormat stats = STATS_NONE; // report printed to the diagnostics after each run
+
+    // Options that change the object file (part of the object cache key)
+    std::string outputFlags() const
+    {
+        std::string flags;
+        if (packedRelocations)
+            flags += "packed-rel ";
+        if (zeroFill)
+            flags += "zero-fill ";
+        if (optimize && !singlePass)
+            flags += "optimize ";
+        return flags;
+    }
+};
+
+// Symbol operand encoded before its value is known (single pass)
+struct Fixup
+{
+    IrWord word;
+    uint section; // section registry index
+    ushort offset; // word offset in section data
+    bool instr; // instruction operand (big endian)
+    bool pcRel;
+};
+
+// Relocation entry waiting for its section symbol id
+struct SectionSymbolRef
+{
+    std::size_t relOffset; // entry offset in relocation section data
+    uint section; // data section registry index
+};
+
+// Operand that cannot be encoded, reported when the section is stitched
+struct WordError
+{
+    const IrWord *word;
+    std::string message;
+};
+
+// .equ whose value is an expression, resolved at .end
+struct EquDef
+{
+    uint symbol;
+    uint expr; // expression node
+    uint line; // source location for errors
+    uint file; // Assembler::fileIndex of the location
+    ushort column;
+    bool resolving; // on the resolution stack (cycle detection)
+};
+
+// Second pass state of one section. Sections are encoded independently
+// (in parallel) and stitched in declaration order, which assigns section
+// symbol ids and reports errors deterministically.
+struct SectionEncoder
+{
+    Section *section = nullptr;
+    Section *relSection = nullptr;
+    ubyte *out = nullptr; // final location of the section data, nullptr to use section->data
+    std::size_t size = 0; // bytes encoded
+    uint begin = 0; // record range in the IR
+    uint end = 0;
+    bool pcRel = false;
+    std::size_t relocations[NUM_REL_TYPES] = {}; // by RelType
+    std::size_t resolvedPcRelocations = 0; // same section PC relative references
+    std::vector<SectionSymbolRef> sectionRefs;
+    std::vector<WordError> errors; // undeclared symbols and invalid expressions
+
+    // Room for the next count bytes of section data
+    ubyte* emit(std::size_t count)
+    {
+        std::size_t offset = size;
+        size += count;
+        if (out)
+            return out + offset;
+        section->data.resize(size);
+        return section->data.data() + offset;
+    }
+};
+
 class Assembler
 {
 public:
-    Assembler();
+    Assembler(const AssemblerOptions& options = AssemblerOptions());
 
     int run(const std::string& inFilename, const std::string& outFilename);
+    // Source already in memory, sourceName is used in diagnostics only:
+    // there is no directory for relative .include and .incbin paths
+    int run(std::string_view source, const std::string& sourceName, const std::string& outFilename);
+    // Assemble source held in memory: no files, no object cache and no
+    // stats report. The object is left empty on errors, diagnostics are
+    // appended as records instead of printed.
+    int assemble(std::string_view source, ObjectBuffer &object, std::vector<Diagnostic> &diagnostics);
+
+    // Diagnostics go to std::cout unless redirected (one stream per assembler)
+    void setDiagnostics(std::ostream& diagnostics) { diagnostics_ = &diagnostics; }
+    std::ostream& diagnostics() const { return *diagnostics_; }
 
     const yy::location& getLocation() const { return location_; }
+    uint lines() const { return lines_; } // source lines of the last run
+    const AssemblerStats& stats() const { return stats_; } // of the last run
+
+    // Next token for the parser: from the lexer or the innermost .rept or
+    // macro expansion. Macro definitions and uses are taken out here.
+    yy::Parser::symbol_type nextToken();
+
+    Atom intern(std::string_view str) { return atoms_.intern(str); }
 
     // Set begin location to current end location and advance end location by count columns (locate new token)
     void locationAddColumns(yy::location::counter_type count);
@@ -42,33 +164,85 @@ public:
     friend class yy::Parser;
 
 private: // Parser callbacks
-    int instr(std::string instrName);
-    int instrArgImmed(string_ushort_variant arg); // $<literal> | $<symbol>
-    int instrArgMemDirOrJmpImmed(string_ushort_variant arg, bool jmpSyntax = false); // <lit/sym> (memdir or jmp immed) | *<lit/sym> (jmp memdir)
-    int instrArgPCRel(const std::string& sym); // %<symbol>
-    int instrArgRegDir(const std::string& reg, bool jmpSyntax = false); // <reg> | *<reg>
-    int instrArgRegInd(const std::string& reg, bool jmpSyntax = false); // [<reg>] | *[<reg>]
-    int instrArgRegIndOff(const std::string& reg, string_ushort_variant off, bool jmpSyntax = false); // [<reg> + <lit/sym>] | *[<reg> + <lit/sym>]
+    int instr(Atom instrName);
+    int instrArgImmed(operand_variant arg); // $<literal> | $<symbol>
+    int instrArgMemDirOrJmpImmed(operand_variant arg, bool jmpSyntax = false); // <lit/sym> (memdir or jmp immed) | *<lit/sym> (jmp memdir)
+    int instrArgPCRel(Atom sym); // %<symbol>
+    int instrArgRegDir(Atom reg, bool jmpSyntax = false); // <reg> | *<reg>
+    int instrArgRegInd(Atom reg, bool jmpSyntax = false); // [<reg>] | *[<reg>]
+    int instrArgRegIndOff(Atom reg, operand_variant off, bool jmpSyntax = false); // [<reg> + <lit/sym>] | *[<reg> + <lit/sym>]
+
+    int dir(Atom dirName);
+    int dirArg(operand_variant arg);
+    int dirArgString(std::string_view str); // first argument only
 
-    int dir(const std::string& dirName);
-    int dirArg(string_ushort_variant arg);
+    int label(Atom label);
 
-    int label(const std::string& label);
+    // Fold op on literal operands, otherwise add an expression node
+    operand_variant exprOp(ExprOp op, const operand_variant &left, const operand_variant &right = operand_variant());
 
 private:
-    int instrFirstPass(const std::string& instrName);
-    int instrSecondPass(const std::string& instrName);
-    int dirFirstPass(const std::string& dirName);
-    int dirSecondPass(const std::string& dirName);
+    // sourceFile: sourceName is a file, relative paths in it start from its directory
+    int run(std::string_view source, const std::string& sourceName, const std::string& outFilename, bool sourceFile);
+    void assembleSource(const char *data, std::size_t size, const std::string& sourceName, bool sourceFile); // both passes
+    bool sourcePath(std::string_view path, std::string &filename); // of an .include or .incbin, false if none
+    void finishStats(std::size_t allocations);
+    void clear(); // drop the per-run state
+    void beginPass(ubyte pass);
+    void beginPhase(Phase phase); // ends the current phase
+
+    // inExpansion: the end of the current expansion reads as end of file.
+    // Counts every token it reads once, re-pushed lookahead aside
+    yy::Parser::symbol_type rawToken(bool inExpansion = false);
+    void skipLine(); // rest of an erroneous line
+    // Body tokens up to the .endr or .endm closing it (nested bodies
+    // included), false if the input ends first
+    bool captureBody(Tokens &body, Directive end);
+    void defineMacro(); // after .macro at the start of a line
+    void expandMacro(uint macro, const yy::location &use, yy::Parser::symbol_type next);
+    void pushExpansion(Expansion &&expansion);
+    void endExpansions(); // back to the lexer
+
+    int include(const std::string& filename);
+    // Location file names kept past the first pass as indexes: 0 for the
+    // source, includeNames_ position + 1 for included files
+    uint fileIndex(const std::string *filename);
+    void errorAt(uint file, uint line, ushort column, const std::string& msg); // at a recorded location
+    // Serialize tokens that are only .equ <symbol>, <literal>, .extern and
+    // .global lines, false for anything else
+    bool compileHeader(const Tokens &tokens, HeaderBlob &blob) const;
+    // Replays the declarations as directives, errors located in the header
+    int loadHeader(const HeaderBlob &blob, const std::string& filename);
 
-    Symbol& getSymbol(const std::string &symbolName);
-    const Symbol& getSectionSymbol(const std::string &sectionName);
+    int instrFirstPass(std::string_view instrName, IrRecord &record);
+    int instrSecondPass(const IrRecord &record, SectionEncoder &encoder);
+    int dirFirstPass(std::string_view dirName);
+    int dirSecondPass(const IrRecord &record, SectionEncoder &encoder);
+    void optimize(); // drop push/pop pairs, thread jumps, then move labels
+    void secondPass();
+    void encodeSection(SectionEncoder &encoder);
+    int stitchSection(SectionEncoder &encoder);
 
-    int processWord(string_ushort_variant &arg, bool instr);
+    int record(const IrRecord &record);
+    IrWord irWord(const operand_variant &arg);
+    uint exprNode(const operand_variant &arg);
+    // Evaluate an expression node, resolving the .equ symbols it uses. Only
+    // reads state once the .equ symbols are resolved (second pass).
+    // message is empty for errors already reported.
+    int evalExpr(uint node, ExprValue &value, std::string &message);
+    int resolveEqu(uint equ);
+    void resolveEqus();
+
+    uint symbolIndex(Atom symbolName); // creates the symbol on first use
+    Symbol& getSymbol(Atom symbolName) { return symbols_[symbolIndex(symbolName)]; }
+    const Symbol& getSectionSymbol(uint sectionIndex);
+
+    int processWord(const IrWord &word, bool instr, SectionEncoder &encoder);
+    int resolveSymbolWord(const IrWord &word, ushort offset, bool instr, ushort &value, SectionEncoder &encoder);
+    int patchFixups();
 
     void writeObjHeader();
 
-    void initRelSection();
 
     void initSymbolTable();
     void insertSymbolTableEntry(Symbol &symbol);
@@ -76,41 +250,63 @@ private:
     void endSymbolTable();
 
     void initStrSection();
-    std::size_t insertStrSectionEntry(const std::string &str);
+    std::size_t insertStrSectionEntry(std::string_view str);
     void endStrSection();
 
     void initSectionHeaderTable();
     void endSectionHeaderTable();
     void endSection();
-    void insertSectionTableEntry(const std::string &sectionName, Section &section, ushort size = 0);
-    void writeSection(Section &section);
+    void insertSectionTableEntry(Section &section, std::size_t size = 0);
+    void placeSection(uint index);
+    void packRelSection(Section &relSection);
+    void layoutDataSections();
+    void writeSection(const Section &section);
+    void endObjFile();
 
     void syntaxError(const std::string& msg);
     void error(const std::string& msg);
     void warning(const std::string& msg);
+    void report(DiagnosticKind kind, const yy::location& loc, const std::string& msg);
 
     yy::Lexer lexer_;
+    yy::Lexer includeLexer_; // lexes an included file into tokens in one go
     yy::Parser parser_;
     yy::location location_;
 
-    std::ofstream outFile_;
+    AssemblerOptions options_;
+    ObjectCache cache_;
+
+    // Per-run storage of sections (data, relocations, symbol table, names),
+    // released in one go at the end of run
+    std::pmr::monotonic_buffer_resource arena_;
+
+    std::ostream *diagnostics_;
+    std::vector<Diagnostic> *records_; // diagnostics of assemble(), nullptr to print them
+    OutputFile out_;
+    std::size_t outSize_; // file layout end
+    std::vector<uint> layout_; // sections in file order
+
+    AssemblerStats stats_;
+    Phase phase_;
+    std::chrono::steady_clock::time_point phaseStart_;
+    double phaseCpuStart_;
 
     ubyte pass_;
     uint lc_;
+    uint dataEnd_; // lc_ after the last instruction, .word or .incbin of the current section
+    uint lines_;
     bool error_;
 
     ObjHeader objHeader_;
 
     // Section
-    SectionMap sections_;
+    SectionList sections_;
+    std::vector<uint> sectionByName_; // registry index by name atom, SECTION_NONE if none
     SectionHeaderTable sectionHeaderTable_;
-    std::string sectionName_; // current section name
-    Section *section_; // current section
-    // Relocation section
-    std::string relSectionName_;
-    Section *relSection_;
-    std::vector<ubyte> sectionDataCache_;
-    std::vector<ubyte> relSectionDataCache_;
+    uint section_; // current data section, SECTION_NONE outside sections
+    std::vector<uint> sectionOrder_; // data sections in declaration order
+    std::vector<Fixup> fixups_;
+    SectionEncoder encoder_; // current section (single pass)
 
     // Instruction data
     ubyte instrNumArgs_;
@@ -119,11 +315,39 @@ private:
     bool pcRel_;
 
     // Directive data
-    std::vector<string_ushort_variant> dirArgs_;
+    std::vector<operand_variant> dirArgs_;
+    std::string_view dirString_; // data() is nullptr if none
+
+    // Expressions
+    ExprNodes exprs_;
+    std::vector<EquDef> equs_;
+    std::vector<uint> equStack_; // symbols of the .equ definitions being resolved
+
+    // Macros and .rept
+    TokenKinds tokenKinds_;
+    std::vector<Macro> macros_;
+    std::vector<uint> macroIndex_; // macro index by atom, MACRO_NONE if none
+    std::vector<Expansion> expansions_; // innermost last
+    Tokens pending_; // read ahead, next last
+    yy::location sourceLocation_; // lexer location while expanding
+    StmtPos stmtPos_; // of the next token
+
+    // Intermediate representation
+    IrRecords ir_;
+    IrWords irWords_;
+    IrBlobs irBlobs_;
+    std::vector<std::unique_ptr<MappedFile>> mappedFiles_; // .incbin and .include files, until the end of the run
+    std::deque<std::string> includeNames_; // file names of the include token locations
+    const std::string *sourceName_; // file name of the source token locations
+    std::pair<const std::string*, uint> lastFile_; // fileIndex cache, file name and index
+    bool externalInputs_; // the object depends on files besides the source (not cached)
+    const std::string *memorySourceName_; // of the source when it isn't a file, nullptr otherwise
 
     // Symbols
     bool labeled_;
-    SymbolMap symbols_;
+    SymbolList symbols_;
+    std::vector<uint> symbolIndex_; // symbol index by atom, SYMBOL_NONE if none
+    AtomTable atoms_;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,40 @@
+#ifndef ATOM_H
+#define ATOM_H
+
+#include <cstddef>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "types.hpp"
+
+// Interning table for identifiers, equal strings share one Atom
+class AtomTable
+{
+public:
+    AtomTable();
+
+    AtomTable(const AtomTable&) = delete;
+    AtomTable& operator=(const AtomTable&) = delete;
+
+    Atom intern(std::string_view str);
+    std::string_view name(Atom atom) const { return names_[atom]; }
+    std::size_t size() const { return names_.size(); }
+
+    // Forget all atoms except ATOM_NONE (keeps the first storage block)
+    void clear();
+
+private:
+    const char* store(std::string_view str);
+
+    std::unordered_map<std::string_view, Atom> atoms_;
+    std::vector<std::string_view> names_;
+
+    // Name storage, blocks are never reallocated so views stay valid
+    std::vector<std::unique_ptr<char[]>> blocks_;
+    char *blockPos_;
+    std::size_t blockLeft_;
+};
+
+#endif
@@ -0,0 +1,22 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "assembler.hpp"
+
+struct BatchJob
+{
+    std::string inFilename;
+    std::string outFilename;
+};
+
+// Assemble jobs on a pool of workers, each worker owning one Assembler.
+// Diagnostics of every job are buffered and written to out as one block,
+// in job order. Returns the highest exit code of all jobs.
+int runBatch(const std::vector<BatchJob>& jobs, const AssemblerOptions& options,
+             unsigned workers, std::ostream& out);
+
+#endif
@@ -0,0 +1,33 @@
+#ifndef DIAGNOSTIC_H
+#define DIAGNOSTIC_H
+
+#include <string>
+
+#include "types.hpp"
+
+enum DiagnosticKind: ubyte
+{
+    DIAG_SYNTAX_ERROR,
+    DIAG_ERROR,
+    DIAG_WARNING
+};
+
+struct Diagnostic
+{
+    DiagnosticKind kind;
+    uint line; // source location
+    uint column;
+    std::string message;
+
+    // As printed after "<file>:<line>:<column>: "
+    std::string text() const
+    {
+        static const char *const KIND_NAMES[] = { "syntax error", "error", "warning" };
+        std::string text = KIND_NAMES[kind];
+        if (!message.empty())
+            text += ", " + message;
+        return text;
+    }
+};
+
+#endif
@@ -1,18 +1,18 @@
 #ifndef DIRECTIVE_H
 #define DIRECTIVE_H
 
-#include <unordered_map>
-
 #include "types.hpp"
+#include "static_map.hpp"
 
 enum DirArgFormat
 {
     NONE, // .dir
     SYM, // .dir <symbol>
     LIT, // .dir <literal>
-    SYM_LIT, // .dir <symbol>, <literal>
+    SYM_EXPR, // .dir <symbol>, <expression>
     SYM_LIST, // .dir <symbol list>
-    SYM_LIT_LIST // .dir <symbol/literal list>
+    SYM_LIT_LIST, // .dir <symbol/literal/expression list>
+    STR_LIT_LIST // .dir <string>[, <literal list>]
 };
 
 enum Directive
@@ -23,12 +23,18 @@ enum Directive
     WORD,
     SKIP,
     EQU,
+    INCBIN,
+    INCLUDE,
+    REPT,
+    ENDR,
+    MACRO,
+    ENDM,
     END
 };
 
 struct DirInfo
 {
-    DirInfo(Directive dir, DirArgFormat argFormat, bool labelsAllowed, bool sectionRequired) :
+    constexpr DirInfo(Directive dir, DirArgFormat argFormat, bool labelsAllowed, bool sectionRequired) :
         dir(dir), argFormat(argFormat), labelsAllowed(labelsAllowed), sectionRequired(sectionRequired)
     {}
 
@@ -38,13 +44,19 @@ struct DirInfo
     bool sectionRequired;
 };
 
-const std::unordered_map<std::string, DirInfo> DIRECTIVES({
+inline constexpr auto DIRECTIVES = makeStaticMap<DirInfo>({
     { "global",  { GLOBAL, SYM_LIST, false, false } },
     { "extern",  { EXTERN, SYM_LIST, false, false } },
     { "section", { SECTION, SYM, false, false } },
     { "word",    { WORD, SYM_LIT_LIST, true, true } },
     { "skip",    { SKIP, LIT, true, true } },
-    { "equ",     { EQU, SYM_LIT, false, false } },
+    { "equ",     { EQU, SYM_EXPR, false, false } },
+    { "incbin",  { INCBIN, STR_LIT_LIST, true, true } },
+    { "include", { INCLUDE, STR_LIT_LIST, false, false } },
+    { "rept",    { REPT, LIT, true, false } },
+    { "endr",    { ENDR, NONE, false, false } },
+    { "macro",   { MACRO, SYM_LIST, false, false } }, // taken before the parser
+    { "endm",    { ENDM, NONE, false, false } },
     { "end",     { END, NONE, false, false } }
 });
 
@@ -0,0 +1,67 @@
+#ifndef EXPR_H
+#define EXPR_H
+
+#include <vector>
+
+#include "types.hpp"
+#include "symbol.hpp"
+
+// Constant expressions. Operators on literals are folded by the parser,
+// what is left (anything with a symbol in it) is kept as a tree of nodes
+// and evaluated once symbol values are known. Arithmetic is unsigned
+// 16 bit, wrapping like the encoded words.
+
+enum ExprOp: ubyte
+{
+    EXPR_LITERAL, // left is the value
+    EXPR_SYMBOL, // left is the symbol index
+    EXPR_NEG, // -left
+    EXPR_ADD,
+    EXPR_SUB,
+    EXPR_MUL,
+    EXPR_DIV,
+    EXPR_SHL,
+    EXPR_SHR,
+    EXPR_AND,
+    EXPR_OR
+};
+
+constexpr const char* EXPR_OP_NAMES[] = { "", "", "-", "+", "-", "*", "/", "<<", ">>", "&", "|" };
+
+struct ExprNode
+{
+    ExprOp op;
+    uint left; // node index, or see ExprOp
+    uint right; // node index (binary operators)
+};
+
+typedef std::vector<ExprNode> ExprNodes;
+
+// Evaluated expression: absolute, or relative to a label or an external
+// symbol (a relocation against it with value as the addend)
+struct ExprValue
+{
+    ushort value = 0;
+    uint symbol = SYMBOL_NONE;
+
+    bool abs() const { return symbol == SYMBOL_NONE; }
+};
+
+// Operator on absolute values (division by zero is checked by the caller)
+inline ushort applyExprOp(ExprOp op, ushort left, ushort right)
+{
+    switch (op) {
+    case EXPR_NEG: return -left;
+    case EXPR_ADD: return left + right;
+    case EXPR_SUB: return left - right;
+    case EXPR_MUL: return left * right;
+    case EXPR_DIV: return left / right;
+    case EXPR_SHL: return right < 16 ? left << right : 0;
+    case EXPR_SHR: return right < 16 ? left >> right : 0;
+    case EXPR_AND: return left & right;
+    case EXPR_OR: return left | right;
+    default: return left;
+    }
+}
+
+#endif
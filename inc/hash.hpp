@@ -0,0 +1,19 @@
+#ifndef HASH_H
+#define HASH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+struct Hash128
+{
+    std::uint64_t low;
+    std::uint64_t high;
+
+    std::string hex() const; // 32 lowercase hex digits
+};
+
+// MurmurHash3 x64 128-bit (non-cryptographic)
+Hash128 hash128(const void *data, std::size_t size, std::uint64_t seed = 0);
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef HEADER_CACHE_H
+#define HEADER_CACHE_H
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "types.hpp"
+
+// Precompiled header: the declarations of an included file made only of
+// .equ <symbol>, <literal> and .extern/.global lists. Entries are packed
+// as { HeaderOp op; ushort value; ubyte nameSize; uint line; ushort column;
+// char name[nameSize] }, line and column those of the end of the
+// declaration, where the parser would report its errors.
+enum HeaderOp: ubyte
+{
+    HDR_EQU,
+    HDR_EXTERN,
+    HDR_GLOBAL
+};
+
+constexpr const char* HEADER_OP_DIRS[] = { "equ", "extern", "global" };
+
+const std::size_t HEADER_ENTRY_SIZE = 10; // without the name
+
+typedef std::vector<ubyte> HeaderBlob;
+
+// Identity of a file version
+struct FileStamp
+{
+    std::int64_t mtime; // nanoseconds
+    std::uint64_t size;
+
+    bool operator==(const FileStamp& other) const { return mtime == other.mtime && size == other.size; }
+};
+
+// Precompiled headers shared by all assemblers of the process (batch and
+// server workers), keyed by path and modification time
+class HeaderCache
+{
+public:
+    static HeaderCache& shared();
+
+    // false if the file can't be read
+    static bool stamp(const std::string& path, FileStamp &stamp);
+
+    // nullptr if not cached or the file changed since
+    std::shared_ptr<const HeaderBlob> find(const std::string& path, const FileStamp& stamp);
+    void insert(const std::string& path, const FileStamp& stamp, std::shared_ptr<const HeaderBlob> blob);
+
+private:
+    struct Entry
+    {
+        FileStamp stamp;
+        std::shared_ptr<const HeaderBlob> blob;
+    };
+
+    std::mutex mutex_;
+    std::unordered_map<std::string, Entry> entries_;
+};
+
+#endif
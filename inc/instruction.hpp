@@ -1,9 +1,8 @@
 #ifndef INSTRUCTION_H
 #define INSTRUCTION_H
 
-#include <unordered_map>
-
 #include "types.hpp"
+#include "static_map.hpp"
 
 typedef ubyte addr_mode_type;
 
@@ -37,7 +36,7 @@ const addr_mode_type ANY_ADDR_MODE =
 
 struct InstrInfo
 {
-    InstrInfo(ubyte opCode, bool jmpSyntax, ubyte numArgs, addr_mode_type arg1AddrModes, addr_mode_type arg2AddrModes) :
+    constexpr InstrInfo(ubyte opCode, bool jmpSyntax, ubyte numArgs, addr_mode_type arg1AddrModes, addr_mode_type arg2AddrModes) :
         opCode(opCode), jmpSyntax(jmpSyntax), numArgs(numArgs), argAddrModes{arg1AddrModes, arg2AddrModes}
     {}
 
@@ -53,11 +52,11 @@ struct InstrArg
 
     bool jmpSyntax;
     addr_mode_type addrMode;
-    string_ushort_variant val; // value
-    string_ushort_variant off; // offset
+    operand_variant val; // value
+    operand_variant off; // offset
 };
 
-const std::unordered_map<std::string, InstrInfo> INSTRUCTIONS({
+inline constexpr auto INSTRUCTIONS = makeStaticMap<InstrInfo>({
     { "halt", { 0x00u, false, 0, 0, 0 } },
     { "int",  { 0x10u, false, 1, REGDIR, 0 } },
     { "iret", { 0x20u, false, 0, 0, 0 } },
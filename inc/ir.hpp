@@ -0,0 +1,64 @@
+#ifndef IR_H
+#define IR_H
+
+#include <vector>
+
+#include "types.hpp"
+#include "symbol.hpp"
+
+// Intermediate representation recorded by the first pass and
+// replayed by the second pass (no re-lexing and re-parsing)
+
+enum IrOp: ubyte
+{
+    IR_SECTION, // .section
+    IR_INSTR,   // instruction
+    IR_WORD,    // .word
+    IR_SKIP,    // .skip
+    IR_BLOB,    // .incbin
+    IR_END      // .end
+};
+
+// Data word operand, symbol values are known only in the second pass
+struct IrWord
+{
+    IrWord() :
+        symbol(SYMBOL_NONE), expr(EXPR_NONE), line(0), file(0), column(0), value(0)
+    {}
+
+    bool literal() const { return symbol == SYMBOL_NONE && expr == EXPR_NONE; }
+
+    uint symbol; // symbol index, SYMBOL_NONE for literals and expressions
+    uint expr; // expression node, EXPR_NONE for literals and symbols
+    uint line; // source location for errors
+    uint file; // Assembler::fileIndex of the location
+    ushort column;
+    ushort value; // literal value
+};
+
+struct IrRecord
+{
+    IrRecord(IrOp op = IR_END, uint arg = 0, uint count = 0) :
+        op(op), size(0), code{0, 0, 0}, pcRel(false), arg(arg), count(count)
+    {}
+
+    IrOp op;
+    ubyte size; // instruction size in bytes (IR_INSTR)
+    ubyte code[3]; // InstrDescr, RegDescr, AddrMode (IR_INSTR)
+    bool pcRel; // pc relative operand (IR_INSTR)
+    uint arg; // section registry index (IR_SECTION), first word (IR_INSTR, IR_WORD), byte count (IR_SKIP), blob (IR_BLOB)
+    uint count; // number of words (IR_WORD)
+};
+
+// Bytes embedded by .incbin, in a file mapped until the end of the run
+struct IrBlob
+{
+    const char *data;
+    uint size;
+};
+
+typedef std::vector<IrRecord> IrRecords;
+typedef std::vector<IrWord> IrWords;
+typedef std::vector<IrBlob> IrBlobs;
+
+#endif
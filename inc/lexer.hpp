@@ -1,7 +1,8 @@
 #ifndef LEXER_H
 #define LEXER_H
 
-#include <istream>
+#include <cstddef>
+#include <string_view>
 
 #ifndef yyFlexLexerOnce
 #undef yyFlexLexer
@@ -21,10 +22,26 @@ namespace yy {
     class Lexer : public yyFlexLexer
     {
     public:
-        Lexer(std::istream* in = (std::istream*)0) : yyFlexLexer(in) {}
+        Lexer() : yyFlexLexer(), input_(nullptr), inputSize_(0), inputPos_(0), offset_(0) {}
         virtual ~Lexer() {}
         yy::Parser::symbol_type get_token(Assembler& assembler);
-        void skip_line(Assembler& assembler);
+
+        // Scan input from memory (restarts the scanner, input must outlive the scan)
+        void reset(const char* input, std::size_t size);
+
+    protected:
+        int LexerInput(char* buf, int maxSize) override;
+
+    private:
+        // Current token text, a view into the input (stays valid while the input does)
+        std::string_view text() const { return std::string_view(input_ + offset_ - yyleng, yyleng); }
+        // Decode the current token as a literal, prefixLen chars are skipped (0x)
+        Literal literal(unsigned base, std::size_t prefixLen) const;
+
+        const char *input_;
+        std::size_t inputSize_;
+        std::size_t inputPos_; // input consumed by the scanner buffer
+        std::size_t offset_; // end of the current token in input
     };
 
 }
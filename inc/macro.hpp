@@ -0,0 +1,64 @@
+#ifndef MACRO_H
+#define MACRO_H
+
+#include <vector>
+
+#include "parser.hpp"
+#include "directive.hpp"
+#include "types.hpp"
+
+// .rept and .macro bodies (and included files) are kept as the tokens the
+// lexer produced and replayed into the parser, so repeated code is lexed
+// once. Replayed tokens keep their location in the body, diagnostics add
+// where the expansion came from.
+
+const uint MACRO_NONE = ~0u;
+const uint MAX_EXPANSION_DEPTH = 64; // nested .rept, macro and .include expansions
+
+typedef std::vector<yy::Parser::symbol_type> Tokens;
+
+struct Macro
+{
+    Atom name;
+    std::vector<Atom> params;
+    Tokens body;
+};
+
+// Tokens being replayed
+struct Expansion
+{
+    Tokens tokens;
+    std::size_t pos; // next token
+    uint count; // repetitions left, the current one included
+    Directive dir; // REPT, MACRO or INCLUDE
+    uint macro; // macro expanded, MACRO_NONE if dir isn't MACRO
+    uint line; // where the expansion was requested
+};
+
+// Where the next token is in its statement. A macro can be used where a
+// statement starts, after a label too.
+enum StmtPos: ubyte
+{
+    STMT_LINE_START,
+    STMT_FIRST_IDENT, // after an identifier at the start of a line
+    STMT_LABELED, // after a label
+    STMT_INSIDE
+};
+
+// Kinds of the tokens expansion looks at, as numbered by Bison
+struct TokenKinds
+{
+    TokenKinds() :
+        ident(yy::Parser::make_IDENT(ATOM_NONE, yy::location()).type_get()),
+        colon(yy::Parser::make_COLON(yy::location()).type_get()),
+        comma(yy::Parser::make_COMMA(yy::location()).type_get()),
+        literal(yy::Parser::make_LITERAL(Literal(), yy::location()).type_get()),
+        period(yy::Parser::make_PERIOD(yy::location()).type_get()),
+        newline(yy::Parser::make_NEWLINE(yy::location()).type_get()),
+        eof(yy::Parser::make_YYEOF(yy::location()).type_get())
+    {}
+
+    int ident, colon, comma, literal, period, newline, eof;
+};
+
+#endif
@@ -1,6 +1,8 @@
 #ifndef OBJ_H
 #define OBJ_H
 
+#include <vector>
+
 #include "types.hpp"
 #include "section.hpp"
 
@@ -16,4 +18,7 @@ struct ObjHeader
     ushort strEntryId = 0; // entry of names section in section header table
 };
 
+// Contents of an object file assembled in memory
+typedef std::vector<ubyte> ObjectBuffer;
+
 #endif
\ No newline at end of file
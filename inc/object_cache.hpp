@@ -0,0 +1,32 @@
+#ifndef OBJECT_CACHE_H
+#define OBJECT_CACHE_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include "hash.hpp"
+
+// Content addressed cache of object files. Entries are keyed by the input
+// bytes, the assembler version and the options that change the output.
+class ObjectCache
+{
+public:
+    explicit ObjectCache(const std::string& dir = std::string()) : dir_(dir) {}
+
+    bool enabled() const { return !dir_.empty(); }
+
+    static Hash128 key(const char *input, std::size_t size, std::string_view flags);
+
+    // Copy a cached object to outFilename, false on a miss
+    bool fetch(const Hash128& key, const std::string& outFilename) const;
+    // Add objFilename to the cache (written to a temporary file, then renamed)
+    bool store(const Hash128& key, const std::string& objFilename) const;
+
+private:
+    std::string path(const Hash128& key) const;
+
+    std::string dir_;
+};
+
+#endif
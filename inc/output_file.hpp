@@ -0,0 +1,47 @@
+#ifndef OUTPUT_FILE_H
+#define OUTPUT_FILE_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "types.hpp"
+
+// Output file filled in place. Regular files are sized with ftruncate and
+// memory mapped; anything else (or a failed mapping) falls back to one
+// buffer written with a single write on close. Memory outputs only have
+// the buffer, taken with release().
+class OutputFile
+{
+public:
+    OutputFile();
+    ~OutputFile();
+
+    OutputFile(const OutputFile&) = delete;
+    OutputFile& operator=(const OutputFile&) = delete;
+
+    bool open(const std::string& filename); // create or truncate
+    void openMemory();
+    // Set the file size, contents are kept and new bytes are zero
+    // (data() may move)
+    void resize(std::size_t size);
+    bool close(); // false if the contents could not be written
+    std::vector<ubyte> release(); // contents of a memory output, closes it
+
+    bool isOpen() const { return fd_ >= 0 || memory_; }
+    bool mapped() const { return mapped_; }
+    ubyte* data() { return mapped_ ? map_ : buffer_.data(); }
+    std::size_t size() const { return size_; }
+
+private:
+    void unmap(); // switch to the buffer fallback
+
+    int fd_;
+    bool memory_;
+    bool mapped_;
+    ubyte *map_;
+    std::size_t size_;
+    std::vector<ubyte> buffer_;
+};
+
+#endif
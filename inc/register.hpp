@@ -1,10 +1,8 @@
 #ifndef REGISTER_H
 #define REGISTER_H
 
-#include <unordered_map>
-#include <string>
-
 #include "types.hpp"
+#include "static_map.hpp"
 
 
 enum Register: ubyte
@@ -15,7 +13,7 @@ enum Register: ubyte
     NUM_REGISTERS
 };
 
-const std::unordered_map<std::string, ubyte> REGISTERS({
+inline constexpr auto REGISTERS = makeStaticMap<ubyte>({
     { "r0", 0u },
     { "r1", 1u },
     { "r2", 2u },
@@ -1,8 +1,7 @@
 #ifndef SECTION_H
 #define SECTION_H
 
-#include <unordered_map>
-#include <string>
+#include <memory_resource>
 #include <vector>
 
 #include "types.hpp"
@@ -17,38 +16,71 @@ enum SectionType: ubyte
     ST_SYM_TAB // section containing symbol table entries
 };
 
-const std::string SECTION_PREFIX = "."; // section symbol prefix
-const std::string REL_SUFFIX = ".rel"; // relocation section suffix
-const std::string STR_SECTION = SECTION_PREFIX + "names.str"; // names section name
-const std::string SYM_TAB_SECTION = SECTION_PREFIX + "sym.tab"; // symbol table section name
+constexpr char SECTION_PREFIX[] = "."; // section symbol prefix
+constexpr char REL_SUFFIX[] = ".rel"; // relocation section suffix
+constexpr char STR_SECTION[] = ".names.str"; // names section name
+constexpr char SYM_TAB_SECTION[] = ".sym.tab"; // symbol table section name
+
+// Registry indices
+const uint SYM_TAB_INDEX = 0; // symbol table, always present
+const uint STR_INDEX = 1; // names, always present
+const uint SECTION_NONE = ~0u; // no section
+
+enum SectionFlags: ubyte
+{
+    SF_NONE = 0,
+    SF_PACKED_REL = 1 << 0, // ST_REL: packed relocation encoding (see RelEntry)
+    SF_ZERO_FILL = 1 << 1 // ST_DATA: only fileSize bytes are stored, the rest is zero
+};
 
 struct SectionEntry
 {
     SectionEntry(SectionType type = ST_NONE) :
-        type(type), nameOffset(0), dataOffset(0), size(0)
+        type(type), flags(SF_NONE), nameOffset(0), dataOffset(0), size(0), fileSize(0)
     {}
 
+    // Bytes of section data in the file
+    ushort storedSize() const { return flags & SF_ZERO_FILL ? fileSize : size; }
+
     SectionType type;
+    ubyte flags; // SectionFlags
     ushort nameOffset; // offset in .str section
     uint dataOffset; // section data offset
     ushort size; // section size in bytes
+    ushort fileSize; // stored bytes (SF_ZERO_FILL), zero otherwise
 };
 
+// Data is allocated from the allocator of the containing SectionList
+// (the assembler's arena)
 struct Section
 {
-    Section() :
-        id(0)
+    typedef std::pmr::polymorphic_allocator<ubyte> allocator_type;
+
+    explicit Section(SectionType type = ST_NONE, Atom name = ATOM_NONE,
+                     const allocator_type& alloc = allocator_type()) :
+        entry(type), data(alloc), id(0), name(name), rel(SECTION_NONE)
+    {}
+    Section(const Section& other, const allocator_type& alloc) :
+        entry(other.entry), data(other.data, alloc), id(other.id), name(other.name), rel(other.rel)
     {}
-    Section(SectionType type) :
-        entry(type)
+    Section(Section&& other, const allocator_type& alloc) :
+        entry(other.entry), data(std::move(other.data), alloc), id(other.id), name(other.name), rel(other.rel)
     {}
+    Section(const Section&) = default;
+    Section(Section&&) = default;
+    Section& operator=(const Section&) = default;
+    Section& operator=(Section&&) = default;
 
     SectionEntry entry;
-    std::vector<ubyte> data;
+    std::pmr::vector<ubyte> data;
     ushort id; // section header table entry index
+    Atom name; // full name, also the section symbol name
+    uint rel; // registry index of the relocation section (data sections)
 };
 
-typedef std::unordered_map<std::string, Section> SectionMap;
+// Section registry, sections are addressed by index. It only grows on
+// .section, so pointers into it are taken after a section is opened.
+typedef std::pmr::vector<Section> SectionList;
 typedef std::vector<SectionEntry> SectionHeaderTable;
 
 #endif
\ No newline at end of file
@@ -0,0 +1,64 @@
+#ifndef SERVER_H
+#define SERVER_H
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "assembler.hpp"
+#include "batch.hpp"
+
+// Long-lived assembler process listening on a Unix domain socket, which
+// saves the process start per file. Each worker owns one Assembler that is
+// reset between jobs, and serves one connection at a time.
+//
+// Protocol (native byte order, the peers share the machine): a client
+// sends requests and reads one response after each.
+//   request:  ServerRequest, then flags, source, source name and output
+//             file name (the sizes given in the header)
+//   response: ServerResponse, then diagnostics text
+// The source is a file name (REQ_FILE) or the source bytes (REQ_SOURCE).
+// flags is AssemblerOptions::outputFlags() of the client, a request whose
+// flags differ from the server's is refused so objects never depend on
+// which process assembled them.
+
+const uint SERVER_MAGIC = 0x53534153; // "SASS"
+
+enum ServerRequestType: ubyte
+{
+    REQ_FILE, // assemble a source file
+    REQ_SOURCE, // assemble the source bytes sent with the request
+    REQ_SHUTDOWN // stop the server, no response
+};
+
+struct ServerRequest
+{
+    uint magic = SERVER_MAGIC;
+    ServerRequestType type = REQ_FILE;
+    ubyte reserved[3] = {};
+    uint flagsSize = 0;
+    uint sourceSize = 0;
+    uint sourceNameSize = 0;
+    uint outFilenameSize = 0;
+};
+
+struct ServerResponse
+{
+    uint magic = SERVER_MAGIC;
+    int res = AE_OK;
+    uint diagnosticsSize = 0;
+};
+
+// Serve requests until a REQ_SHUTDOWN (or a failure to listen, AE_FILE)
+int runServer(const std::string& socketPath, const AssemblerOptions& options,
+              unsigned workers, std::ostream& out);
+
+// Send jobs to a server one by one over a single connection, printing the
+// diagnostics to out. Relative file names are made absolute, an input of
+// "-" sends standard input as source bytes (with no directory, so relative
+// .include and .incbin paths in it are errors).
+int runClient(const std::string& socketPath, const std::vector<BatchJob>& jobs,
+              const AssemblerOptions& options, std::ostream& out);
+int stopServer(const std::string& socketPath, std::ostream& out);
+
+#endif
@@ -0,0 +1,99 @@
+#ifndef STATIC_MAP_H
+#define STATIC_MAP_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <utility>
+
+template<typename T>
+struct StaticMapEntry
+{
+    std::string_view key;
+    T value;
+};
+
+// Read-only string_view keyed table built entirely at compile time.
+// The constructor searches for a hash seed that maps every key to its own
+// slot, so a lookup is one hash, one slot load and one key compare.
+template<typename T, std::size_t N>
+class StaticMap
+{
+public:
+    static constexpr std::size_t SLOTS = [] {
+        std::size_t slots = 1;
+        while (slots < 4 * N)
+            slots <<= 1;
+        return slots;
+    }();
+
+    static_assert(N < 0xFFu, "StaticMap slot indices are bytes");
+
+    constexpr StaticMap(const StaticMapEntry<T> (&entries)[N]) :
+        StaticMap(entries, std::make_index_sequence<N>())
+    {}
+
+    // Returns nullptr when the key is not in the table
+    constexpr const T* find(std::string_view key) const
+    {
+        std::size_t i = indexOf(key);
+        return i == N ? nullptr : &entries_[i].value;
+    }
+
+    // Position of the key in the entry list (for arrays parallel to it),
+    // N when the key is not in the table
+    constexpr std::size_t indexOf(std::string_view key) const
+    {
+        std::uint8_t slot = slots_[hash(key, seed_) & (SLOTS - 1)];
+        if (slot == 0 || entries_[slot - 1].key != key)
+            return N;
+        return slot - 1;
+    }
+
+    constexpr std::size_t size() const { return N; }
+    constexpr const StaticMapEntry<T>* begin() const { return entries_.data(); }
+    constexpr const StaticMapEntry<T>* end() const { return entries_.data() + N; }
+
+private:
+    template<std::size_t... I>
+    constexpr StaticMap(const StaticMapEntry<T> (&entries)[N], std::index_sequence<I...>) :
+        entries_{{ entries[I]... }}, slots_{}, seed_(0)
+    {
+        for (;; ++seed_) {
+            std::array<std::uint8_t, SLOTS> slots{};
+            std::size_t i = 0;
+            for (; i < N; ++i) {
+                std::size_t slot = hash(entries_[i].key, seed_) & (SLOTS - 1);
+                if (slots[slot] != 0)
+                    break;
+                slots[slot] = (std::uint8_t)(i + 1);
+            }
+            if (i == N) {
+                slots_ = slots;
+                return;
+            }
+        }
+    }
+
+    // FNV-1a with the seed folded into the offset basis
+    static constexpr std::uint32_t hash(std::string_view key, std::uint32_t seed)
+    {
+        std::uint32_t h = 2166136261u ^ seed;
+        for (char c : key)
+            h = (h ^ (std::uint8_t)c) * 16777619u;
+        return h ^ (h >> 15);
+    }
+
+    std::array<StaticMapEntry<T>, N> entries_;
+    std::array<std::uint8_t, SLOTS> slots_; // entry index + 1, 0 when empty
+    std::uint32_t seed_;
+};
+
+template<typename T, std::size_t N>
+constexpr StaticMap<T, N> makeStaticMap(const StaticMapEntry<T> (&entries)[N])
+{
+    return StaticMap<T, N>(entries);
+}
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef STATS_H
+#define STATS_H
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+#include "directive.hpp"
+#include "instruction.hpp"
+#include "symbol.hpp"
+
+enum Phase: int
+{
+    PHASE_NONE = -1,
+    PHASE_PARSE, // pass 0: lexing, parsing and recording (encoding in single pass mode)
+    PHASE_ENCODE, // pass 1: encoding the recorded sections
+    PHASE_WRITE, // object file layout and writing
+    NUM_PHASES
+};
+
+constexpr const char* PHASE_NAMES[NUM_PHASES] = { "pass0", "pass1", "write" };
+
+const std::size_t NUM_INSTRUCTIONS = INSTRUCTIONS.size();
+const std::size_t NUM_DIRECTIVES = END + 1;
+const std::size_t NUM_REL_TYPES = RT_PC + 1;
+
+// Measurements of the last run, cheap enough to always collect
+struct AssemblerStats
+{
+    bool cached = false; // object taken from the cache, nothing assembled
+    double wall[NUM_PHASES] = {}; // seconds
+    double cpu[NUM_PHASES] = {}; // seconds, summed over the threads working on the phase
+    std::size_t tokens = 0; // from the lexer, plus those replayed by .rept and macro expansions
+    std::size_t lines = 0;
+    std::size_t instructions[NUM_INSTRUCTIONS] = {}; // by INSTRUCTIONS entry, so push and str apart
+    std::size_t directives[NUM_DIRECTIVES] = {}; // by Directive
+    std::size_t symbols = 0;
+    std::size_t sectionSymbols = 0; // added to the symbol table for relocations
+    std::size_t relocations[NUM_REL_TYPES] = {}; // by RelType
+    std::size_t resolvedPcRelocations = 0; // PC relative references encoded without a relocation
+    std::size_t removedInstructions = 0; // by the peephole pass (-O)
+    std::size_t threadedJumps = 0; // jumps sent straight to the target of the jump they hit (-O)
+    std::size_t precompiledHeaders = 0; // includes loaded from their declarations
+    std::size_t cachedHeaders = 0; // of which compiled by an earlier run of the process
+    std::size_t heapAllocations = 0; // process wide, so it includes concurrent runs in batch mode
+    long peakRssKb = 0; // process peak resident set size
+};
+
+enum StatsFormat: ubyte
+{
+    STATS_NONE,
+    STATS_TEXT,
+    STATS_JSON
+};
+
+// CPU time of the calling thread in seconds
+double threadCpuSeconds();
+// Peak resident set size of the process in KB
+long peakRssKb();
+
+void printStats(std::ostream& out, const AssemblerStats& stats, const std::string& filename, StatsFormat format);
+
+#endif
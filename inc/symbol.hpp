@@ -1,14 +1,10 @@
 #ifndef SYMBOL_H
 #define SYMBOL_H
 
-#include <unordered_map>
-#include <string>
 #include <vector>
 
 #include "types.hpp"
 
-class Symbol;
-
 enum RelType: ubyte
 {
     RT_SYM_16, // little endian
@@ -19,14 +15,22 @@ enum RelType: ubyte
 struct RelEntry
 {
     RelEntry(RelType type, ushort offset, uint symbolId) :
-        type(type), offset(offset), symbolId(symbolId)
+        type(type), reserved(0), offset(offset), symbolId(symbolId)
     {}
 
     RelType type;
+    ubyte reserved; // explicit padding, always written as zero
     ushort offset;
     ushort symbolId;
 };
 
+// Packed relocation section (SF_PACKED_REL): entries sorted by offset,
+// each one is two unsigned LEB128 varints
+//   (offset - previous offset) << 2 | type
+//   zigzag(symbolId - previous symbolId)
+// with both previous values starting at zero. An entry takes at most
+// sizeof(RelEntry) bytes, usually two.
+
 enum SymbolBind: ubyte
 {
     SYMB_LOCAL,
@@ -57,10 +61,12 @@ struct SymbolEntry
     uint sectionEntryId;
 };
 
+const uint EQU_NONE = ~0u; // no pending .equ definition
+
 struct Symbol
 {
     Symbol() :
-        global(false), external(false), used(false), section(""), id(0)
+        global(false), external(false), used(false), section(0), id(0), name(ATOM_NONE), equ(EQU_NONE)
     {}
 
     bool defined() const { return entry.type != SYMT_UNDEF; }
@@ -71,11 +77,16 @@ struct Symbol
     bool external;
     bool used;
     SymbolEntry entry;
-    std::string section;
+    uint section; // data section registry index (labels and section symbols)
     uint id; // symbol table entry id
+    Atom name;
+    uint equ; // unresolved .equ definition, EQU_NONE if none
 };
 
-typedef std::unordered_map<std::string, Symbol> SymbolMap;
-typedef std::vector<SymbolEntry> SymbolTable;
+const uint SYMBOL_NONE = ~0u; // no symbol index
+
+// Symbols in creation order (keeps the symbol table deterministic),
+// found by atom through an index vector
+typedef std::vector<Symbol> SymbolList;
 
 #endif
\ No newline at end of file
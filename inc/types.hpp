@@ -4,12 +4,34 @@
 #include <cstdint>
 #include <variant>
 #include <string>
+#include <string_view>
 
 typedef uint8_t ubyte;
 typedef uint16_t ushort;
 typedef uint32_t uint;
 
-typedef std::variant<std::string, ushort> string_ushort_variant;
+// Interned identifier (see AtomTable)
+enum Atom: uint
+{
+    ATOM_NONE = 0 // empty string
+};
+
+// Expression node index (see expr.hpp)
+enum Expr: uint
+{
+    EXPR_NONE = ~0u
+};
+
+// Operand: symbol, literal or expression
+typedef std::variant<Atom, ushort, Expr> operand_variant;
+
+// Numeric literal decoded by the lexer
+struct Literal
+{
+    ushort value;
+    bool overflow; // value does not fit in 16 bits
+    std::string_view text; // source text, for diagnostics
+};
 
 
 #endif
\ No newline at end of file
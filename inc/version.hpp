@@ -0,0 +1,8 @@
+#ifndef VERSION_H
+#define VERSION_H
+
+// Bump whenever the object file output changes, file layout included (part
+// of the object cache key)
+constexpr char ASSEMBLER_VERSION[] = "1.2.0";
+
+#endif
@@ -0,0 +1,62 @@
+#include "alloc_stats.hpp"
+
+#include <cstdlib>
+#include <new>
+
+// Replacement global allocation functions counting heap allocations.
+// Part of the executable only: programs using the library keep their own
+// (heapAllocationCount() then stays zero).
+
+void* operator new(std::size_t size)
+{
+    countHeapAllocation();
+    if (size == 0)
+        size = 1;
+    for (;;) {
+        if (void *ptr = std::malloc(size))
+            return ptr;
+        std::new_handler handler = std::get_new_handler();
+        if (!handler)
+            throw std::bad_alloc();
+        handler();
+    }
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    try {
+        return operator new(size);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return operator new(size, std::nothrow);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
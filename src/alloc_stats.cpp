@@ -0,0 +1,15 @@
+#include "alloc_stats.hpp"
+
+#include <atomic>
+
+static std::atomic<std::size_t> allocationCount(0);
+
+std::size_t heapAllocationCount()
+{
+    return allocationCount.load(std::memory_order_relaxed);
+}
+
+void countHeapAllocation()
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+}
@@ -0,0 +1,9 @@
+#include "assemble.hpp"
+
+AssembleResult assemble(std::string_view source, const AssemblerOptions& options)
+{
+    AssembleResult result;
+    Assembler assembler(options);
+    result.status = assembler.assemble(source, result.object, result.diagnostics);
+    return result;
+}
@@ -1,85 +1,223 @@
 #include "assembler.hpp"
 
 #include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
 #include <cstdio>
+#include <cstring>
+#include <thread>
 
-Assembler::Assembler() :
-    lexer_(), parser_(lexer_, *this)
+#include "mapped_file.hpp"
+#include "alloc_stats.hpp"
+
+const std::size_t ARENA_BLOCK_SIZE = 64 * 1024; // first arena block, grows geometrically
+
+// Below this many IR records the second pass encodes sections on the calling thread
+const std::size_t PARALLEL_MIN_RECORDS = 16 * 1024;
+
+Assembler::Assembler(const AssemblerOptions& options) :
+    lexer_(), parser_(lexer_, *this), options_(options), cache_(options.cacheDir),
+    arena_(ARENA_BLOCK_SIZE), diagnostics_(&std::cout), records_(nullptr), phase_(PHASE_NONE),
+    phaseCpuStart_(0), sections_(&arena_)
 {}
 
 int Assembler::run(const std::string& inFilename, const std::string& outFilename)
 {
-    std::ifstream inFile(inFilename);
-    if (!inFile.is_open()) {
-        std::cout << "Cannot open file: " << inFilename << std::endl;
+    MappedFile inFile;
+    if (!inFile.open(inFilename)) {
+        *diagnostics_ << "Cannot open file: " << inFilename << std::endl;
         return AE_FILE;
     }
-    outFile_.open(outFilename, std::ios_base::binary);
-    if (!outFile_.is_open()) {
-        inFile.close();
-        std::cout << "Cannot open file for writing: " << outFilename << std::endl;
+
+    return run(std::string_view(inFile.data(), inFile.size()), inFilename, outFilename, true);
+}
+
+int Assembler::run(std::string_view source, const std::string& sourceName, const std::string& outFilename)
+{
+    return run(source, sourceName, outFilename, false);
+}
+
+int Assembler::run(std::string_view source, const std::string& sourceName, const std::string& outFilename,
+                   bool sourceFile)
+{
+    stats_ = AssemblerStats();
+    std::size_t allocations = heapAllocationCount();
+
+    Hash128 cacheKey{};
+    if (cache_.enabled()) {
+        cacheKey = ObjectCache::key(source.data(), source.size(), options_.outputFlags());
+        if (cache_.fetch(cacheKey, outFilename)) {
+            lines_ = 0; // not parsed
+            stats_.cached = true;
+            stats_.heapAllocations = heapAllocationCount() - allocations;
+            stats_.peakRssKb = peakRssKb();
+            printStats(*diagnostics_, stats_, sourceName, options_.stats);
+            return AE_OK;
+        }
+    }
+
+    if (!out_.open(outFilename)) {
+        *diagnostics_ << "Cannot open file for writing: " << outFilename << std::endl;
         return AE_FILE;
     }
 
-    lexer_.switch_streams(&inFile);
+    assembleSource(source.data(), source.size(), sourceName, sourceFile);
+    if (!out_.close() && !error_) {
+        *diagnostics_ << "Cannot write file: " << outFilename << std::endl;
+        error_ = true;
+    }
+    beginPhase(PHASE_NONE);
+    if (error_) {
+        std::remove(outFilename.c_str());
+        *diagnostics_ << "Deleting output file: " << outFilename << std::endl;
+    } else if (cache_.enabled() && !externalInputs_) // the key covers the source only
+        cache_.store(cacheKey, outFilename);
 
-    writeObjHeader();
+    finishStats(allocations);
+    printStats(*diagnostics_, stats_, sourceName, options_.stats);
+    clear();
+
+    return error_ ? AE_SYNTAX : AE_OK;
+}
+
+int Assembler::assemble(std::string_view source, ObjectBuffer &object, std::vector<Diagnostic> &diagnostics)
+{
+    static const std::string SOURCE_NAME = "<memory>";
+
+    stats_ = AssemblerStats();
+    std::size_t allocations = heapAllocationCount();
+
+    records_ = &diagnostics;
+    out_.openMemory();
+    assembleSource(source.data(), source.size(), SOURCE_NAME, false);
+    beginPhase(PHASE_NONE);
+    if (error_)
+        object.clear();
+    else
+        object = out_.release();
+    out_.close();
+    records_ = nullptr;
+
+    finishStats(allocations);
+    clear();
+
+    return error_ ? AE_SYNTAX : AE_OK;
+}
+
+void Assembler::assembleSource(const char *data, std::size_t size, const std::string& sourceName, bool sourceFile)
+{
+    outSize_ = sizeof(ObjHeader);
     initSectionHeaderTable();
     initSymbolTable();
     initStrSection();
 
     error_ = false;
+    externalInputs_ = false;
+    memorySourceName_ = sourceFile ? nullptr : &sourceName;
+    sourceName_ = &sourceName;
+    lastFile_ = { &sourceName, 0 };
+
+    // First pass parses the source and records the intermediate representation
+    // (or encodes it right away in single pass mode)
+    beginPhase(PHASE_PARSE);
+    beginPass(0);
+    lexer_.reset(data, size);
+    location_.initialize(&sourceName);
+    stmtPos_ = STMT_LINE_START;
 
-    for (pass_ = 0; pass_ < 2; ++pass_) {
-        inFile.seekg(0);
-        location_.initialize(&inFilename);
+    int res;
 
-        instrNumArgs_ = 0;
-        dirArgs_.clear();
-        labeled_ = false;
-        pcRel_ = false;
-        sectionName_ = "";
-        relSectionName_ = "";
-        section_ = nullptr;
-        relSection_ = nullptr;
-        lc_ = 0;
-        
-        int res;
-
-        while ((res = parser_.parse()) != AE_END) {
-            if (res == AE_OK) {
-                dir("end"); // implicit .end on eof
-                break;
-            } else {
-                error_ = true;
-                if (res == AE_SYNTAX) {
-                    instrNumArgs_ = 0;
-                    dirArgs_.clear();
-                    labeled_ = false;
-                    pcRel_ = false;
-                    lexer_.skip_line(*this); // skip erroneous line
-                }
+    while ((res = parser_.parse()) != AE_END) {
+        if (res == AE_OK) {
+            dir(intern("end")); // implicit .end on eof
+            break;
+        } else {
+            error_ = true;
+            if (res == AE_SYNTAX) {
+                instrNumArgs_ = 0;
+                dirArgs_.clear();
+                dirString_ = std::string_view();
+                labeled_ = false;
+                pcRel_ = false;
+                skipLine(); // skip erroneous line
             }
         }
+    }
 
-        if (error_)
-            break;
+    endExpansions();
+    lines_ = location_.end.line;
+
+    // Second pass replays the records
+    if (!error_ && !options_.singlePass) {
+        beginPhase(PHASE_ENCODE);
+        beginPass(1);
+        secondPass();
     }
 
     location_.initialize();
-    lexer_.switch_streams();
-    inFile.close();
-    outFile_.close();
-    if (error_) {
-        std::remove(outFilename.c_str());
-        std::cout << "Deleting output file: " << outFilename << std::endl;
-    }
+    lexer_.reset(nullptr, 0);
+}
+
+void Assembler::finishStats(std::size_t allocations)
+{
+    stats_.lines = lines_;
+    stats_.symbols = symbols_.size();
+    stats_.heapAllocations = heapAllocationCount() - allocations;
+    stats_.peakRssKb = peakRssKb();
+}
 
-    sections_.clear();
+void Assembler::clear()
+{
     sectionHeaderTable_.clear();
+    sectionOrder_.clear();
+    sectionByName_.clear();
+    layout_.clear();
+    fixups_.clear();
+    ir_.clear();
+    irWords_.clear();
+    irBlobs_.clear();
+    mappedFiles_.clear(); // unmaps them
+    includeNames_.clear();
+    exprs_.clear();
+    equs_.clear();
     symbols_.clear();
+    symbolIndex_.clear();
+    macros_.clear();
+    macroIndex_.clear();
+    atoms_.clear();
+
+    // Sections live in the arena: deallocation is a no-op, the memory
+    // goes back in one release (a fresh list doesn't allocate until used)
+    SectionList(&arena_).swap(sections_);
+    arena_.release();
+}
 
-    return error_ ? AE_SYNTAX : AE_OK;
+void Assembler::beginPass(ubyte pass)
+{
+    pass_ = pass;
+    instrNumArgs_ = 0;
+    dirArgs_.clear();
+    dirString_ = std::string_view();
+    labeled_ = false;
+    pcRel_ = false;
+    section_ = SECTION_NONE;
+    encoder_ = SectionEncoder();
+    lc_ = 0;
+    dataEnd_ = 0;
+}
+
+void Assembler::beginPhase(Phase phase)
+{
+    auto now = std::chrono::steady_clock::now();
+    double cpu = threadCpuSeconds();
+    if (phase_ != PHASE_NONE) {
+        stats_.wall[phase_] += std::chrono::duration<double>(now - phaseStart_).count();
+        stats_.cpu[phase_] += cpu - phaseCpuStart_;
+    }
+    phase_ = phase;
+    phaseStart_ = now;
+    phaseCpuStart_ = cpu;
 }
 
 void Assembler::locationAddColumns(yy::location::counter_type count)
@@ -92,9 +230,442 @@ void Assembler::locationAddLines(yy::location::counter_type count)
     location_.lines(count);
 }
 
-int Assembler::instr(std::string instrName)
+yy::Parser::symbol_type Assembler::nextToken()
+{
+    for (;;) {
+        yy::Parser::symbol_type token = rawToken();
+        int kind = token.type_get();
+        StmtPos pos = stmtPos_;
+        if (kind == tokenKinds_.newline)
+            stmtPos_ = STMT_LINE_START;
+        else if (pos == STMT_LINE_START && kind == tokenKinds_.ident)
+            stmtPos_ = STMT_FIRST_IDENT;
+        else if (pos == STMT_FIRST_IDENT && kind == tokenKinds_.colon)
+            stmtPos_ = STMT_LABELED;
+        else
+            stmtPos_ = STMT_INSIDE;
+
+        // Macro definitions never reach the parser
+        if (pos == STMT_LINE_START && kind == tokenKinds_.period) {
+            yy::Parser::symbol_type name = rawToken();
+            if (name.type_get() == tokenKinds_.ident && atoms_.name(name.value.as<Atom>()) == "macro") {
+                defineMacro();
+                continue;
+            }
+            pending_.push_back(std::move(name));
+            return token;
+        }
+
+        // A macro use is replaced by its body, unless it's a label of the same name
+        if ((pos == STMT_LINE_START || pos == STMT_LABELED) && kind == tokenKinds_.ident) {
+            Atom name = token.value.as<Atom>();
+            if (name < macroIndex_.size() && macroIndex_[name] != MACRO_NONE) {
+                yy::Parser::symbol_type next = rawToken();
+                if (next.type_get() != tokenKinds_.colon) {
+                    expandMacro(macroIndex_[name], token.location, std::move(next));
+                    stmtPos_ = pos;
+                    continue;
+                }
+                pending_.push_back(std::move(next));
+            }
+        }
+        return token;
+    }
+}
+
+yy::Parser::symbol_type Assembler::rawToken(bool inExpansion)
+{
+    if (!pending_.empty()) {
+        yy::Parser::symbol_type token = std::move(pending_.back());
+        pending_.pop_back();
+        return token;
+    }
+
+    while (!expansions_.empty()) {
+        Expansion &expansion = expansions_.back();
+        if (expansion.pos < expansion.tokens.size()) {
+            location_ = expansion.tokens[expansion.pos].location;
+            ++stats_.tokens;
+            return expansion.tokens[expansion.pos++];
+        }
+        if (inExpansion)
+            return yy::Parser::make_YYEOF(location_);
+        if (--expansion.count > 0) {
+            expansion.pos = 0;
+            continue;
+        }
+        expansions_.pop_back();
+        if (expansions_.empty())
+            location_ = sourceLocation_;
+    }
+
+    ++stats_.tokens;
+    return lexer_.get_token(*this);
+}
+
+void Assembler::skipLine()
+{
+    int kind;
+    do {
+        kind = rawToken().type_get();
+    } while (kind != tokenKinds_.newline && kind != tokenKinds_.eof);
+    stmtPos_ = STMT_LINE_START;
+}
+
+bool Assembler::captureBody(Tokens &body, Directive end)
+{
+    uint depth = 0;
+    bool lineStart = true;
+    for (;;) {
+        yy::Parser::symbol_type token = rawToken(true);
+        if (token.type_get() == tokenKinds_.eof)
+            return false;
+
+        if (lineStart && token.type_get() == tokenKinds_.period) {
+            yy::Parser::symbol_type name = rawToken(true);
+            if (name.type_get() == tokenKinds_.eof)
+                return false;
+            const DirInfo *info = name.type_get() == tokenKinds_.ident
+                ? DIRECTIVES.find(atoms_.name(name.value.as<Atom>())) : nullptr;
+            if (info && (info->dir == REPT || info->dir == MACRO))
+                ++depth;
+            else if (info && (info->dir == ENDR || info->dir == ENDM) && depth-- == 0) {
+                ++stats_.directives[info->dir];
+                if (info->dir != end)
+                    syntaxError(std::string("unexpected .") + (end == ENDR ? "endm, expected .endr" : "endr, expected .endm"));
+                return true;
+            }
+            body.push_back(std::move(token));
+            lineStart = name.type_get() == tokenKinds_.newline;
+            body.push_back(std::move(name));
+            continue;
+        }
+
+        lineStart = token.type_get() == tokenKinds_.newline;
+        body.push_back(std::move(token));
+    }
+}
+
+void Assembler::defineMacro()
+{
+    ++stats_.directives[MACRO];
+    yy::location start = location_;
+
+    // .macro <name> [<param>[,] ...]
+    Macro macro;
+    bool named = false, valid = true;
+    int kind;
+    for (;;) {
+        yy::Parser::symbol_type token = rawToken();
+        kind = token.type_get();
+        if (kind == tokenKinds_.newline || kind == tokenKinds_.eof)
+            break;
+        if (kind == tokenKinds_.ident && !named) {
+            macro.name = token.value.as<Atom>();
+            named = true;
+        } else if (kind == tokenKinds_.ident)
+            macro.params.push_back(token.value.as<Atom>());
+        else if (kind != tokenKinds_.comma || !named) {
+            valid = false;
+            break;
+        }
+    }
+    valid = valid && named;
+    if (!valid) {
+        syntaxError("expected directive syntax: .macro <IDENT> <IDENT list>");
+        if (kind != tokenKinds_.newline && kind != tokenKinds_.eof)
+            skipLine();
+    }
+
+    // The body is read even after a bad header, so it isn't assembled
+    if (!captureBody(macro.body, ENDM)) {
+        error_ = true;
+        report(DIAG_SYNTAX_ERROR, start, "missing .endm");
+        return;
+    }
+    if (!valid)
+        return;
+
+    if (macro.name >= macroIndex_.size())
+        macroIndex_.resize(atoms_.size(), MACRO_NONE);
+    if (macroIndex_[macro.name] != MACRO_NONE) {
+        error_ = true;
+        report(DIAG_ERROR, start, "macro already defined: " + std::string(atoms_.name(macro.name)));
+        return;
+    }
+    macroIndex_[macro.name] = macros_.size();
+    macros_.push_back(std::move(macro));
+}
+
+void Assembler::expandMacro(uint index, const yy::location &use, yy::Parser::symbol_type next)
+{
+    // Arguments are the tokens between commas, up to the end of the line
+    Tokens line;
+    line.push_back(std::move(next));
+    while (line.back().type_get() != tokenKinds_.newline && line.back().type_get() != tokenKinds_.eof)
+        line.push_back(rawToken());
+    std::vector<std::pair<std::size_t, std::size_t>> args; // token ranges in line
+    if (line.size() > 1) {
+        args.push_back({ 0, 0 });
+        for (std::size_t i = 0; i + 1 < line.size(); ++i) {
+            if (line[i].type_get() == tokenKinds_.comma)
+                args.push_back({ i + 1, i + 1 });
+            else
+                args.back().second = i + 1;
+        }
+    }
+    bool newline = line.back().type_get() == tokenKinds_.newline;
+
+    const Macro &macro = macros_[index];
+    std::string message;
+    if (args.size() != macro.params.size())
+        message = "macro " + std::string(atoms_.name(macro.name)) + " expects " + std::to_string(macro.params.size())
+                  + " arguments, got " + std::to_string(args.size());
+    else if (expansions_.size() >= MAX_EXPANSION_DEPTH)
+        message = "macro expansion too deep: " + std::string(atoms_.name(macro.name));
+    if (!message.empty()) {
+        error_ = true;
+        report(DIAG_SYNTAX_ERROR, use, message);
+        if (newline)
+            pending_.push_back(std::move(line.back()));
+        return;
+    }
+
+    Expansion expansion{ Tokens(), 0, 1, MACRO, index, (uint)use.begin.line };
+    expansion.tokens.reserve(macro.body.size() + 1);
+    for (const yy::Parser::symbol_type &token : macro.body) {
+        auto param = macro.params.end();
+        if (token.type_get() == tokenKinds_.ident)
+            param = std::find(macro.params.begin(), macro.params.end(), token.value.as<Atom>());
+        if (param == macro.params.end())
+            expansion.tokens.push_back(token);
+        else {
+            const std::pair<std::size_t, std::size_t> &arg = args[param - macro.params.begin()];
+            for (std::size_t i = arg.first; i < arg.second; ++i)
+                expansion.tokens.push_back(line[i]);
+        }
+    }
+    // The newline of the use ends the last statement of the body
+    if (newline)
+        expansion.tokens.push_back(std::move(line.back()));
+
+    pushExpansion(std::move(expansion));
+}
+
+void Assembler::pushExpansion(Expansion &&expansion)
+{
+    if (expansion.tokens.empty() || !expansion.count)
+        return;
+    if (expansions_.empty())
+        sourceLocation_ = location_;
+    expansions_.push_back(std::move(expansion));
+}
+
+uint Assembler::fileIndex(const std::string *filename)
+{
+    // Words come in runs from one file, so the last answer usually holds
+    if (filename != lastFile_.first) {
+        uint index = 0;
+        for (uint i = includeNames_.size(); i > 0 && !index; --i)
+            if (&includeNames_[i - 1] == filename)
+                index = i;
+        lastFile_ = { filename, index };
+    }
+    return lastFile_.second;
+}
+
+void Assembler::errorAt(uint file, uint line, ushort column, const std::string& msg)
+{
+    yy::location location = location_;
+    location.begin.filename = file == 0 ? sourceName_ : &includeNames_[file - 1];
+    location.begin.line = line;
+    location.begin.column = column;
+    error_ = true;
+    report(DIAG_ERROR, location, msg);
+}
+
+// Relative paths in a source are relative to its directory, an error in a
+// source that isn't a file (the server's working directory is unrelated)
+bool Assembler::sourcePath(std::string_view path, std::string &filename)
+{
+    const std::string &sourceName = *location_.begin.filename;
+    filename = path;
+    if (path.empty() || path[0] == '/')
+        return true;
+    if (&sourceName == memorySourceName_) {
+        error("relative path in a source without a file: " + filename);
+        return false;
+    }
+    std::size_t slash = sourceName.rfind('/');
+    if (slash != std::string::npos)
+        filename = sourceName.substr(0, slash + 1) + filename;
+    return true;
+}
+
+int Assembler::include(const std::string& filename)
+{
+    FileStamp stamp;
+    if (!HeaderCache::stamp(filename, stamp)) {
+        error("cannot open file: " + filename);
+        return AE_SYNTAX_NOSKIP;
+    }
+
+    // A header already compiled in this process is loaded from its symbols
+    std::shared_ptr<const HeaderBlob> header = HeaderCache::shared().find(filename, stamp);
+    if (header) {
+        ++stats_.cachedHeaders;
+        return loadHeader(*header, filename);
+    }
+
+    std::unique_ptr<MappedFile> file = std::make_unique<MappedFile>();
+    if (!file->open(filename)) {
+        error("cannot open file: " + filename);
+        return AE_SYNTAX_NOSKIP;
+    }
+
+    // The whole file is lexed here, its tokens located in it
+    Expansion expansion{ Tokens(), 0, 1, INCLUDE, MACRO_NONE, (uint)location_.begin.line };
+    yy::location includer = location_;
+    includeNames_.push_back(filename);
+    location_.initialize(&includeNames_.back());
+    includeLexer_.reset(file->data(), file->size());
+    for (;;) {
+        yy::Parser::symbol_type token = includeLexer_.get_token(*this);
+        if (token.type_get() == tokenKinds_.eof)
+            break;
+        expansion.tokens.push_back(std::move(token));
+    }
+    includeLexer_.reset(nullptr, 0);
+    if (!expansion.tokens.empty() && expansion.tokens.back().type_get() != tokenKinds_.newline)
+        expansion.tokens.push_back(yy::Parser::make_NEWLINE(location_)); // ends the last statement
+    location_ = includer;
+
+    HeaderBlob blob;
+    if (compileHeader(expansion.tokens, blob)) {
+        header = std::make_shared<const HeaderBlob>(std::move(blob));
+        HeaderCache::shared().insert(filename, stamp, header);
+        return loadHeader(*header, filename);
+    }
+
+    if (expansions_.size() >= MAX_EXPANSION_DEPTH) {
+        error("includes nested too deep: " + filename);
+        return AE_SYNTAX_NOSKIP;
+    }
+    mappedFiles_.push_back(std::move(file)); // literal tokens point into it
+    pushExpansion(std::move(expansion));
+    return AE_OK;
+}
+
+bool Assembler::compileHeader(const Tokens &tokens, HeaderBlob &blob) const
+{
+    auto kind = [&tokens](std::size_t i) { return i < tokens.size() ? tokens[i].type_get() : -1; };
+    // end: the newline closing the declaration
+    auto append = [&blob](HeaderOp op, ushort value, std::string_view name, const yy::location &end) {
+        if (name.size() > 0xFF || end.begin.column > 0xFFFF)
+            return false;
+        uint line = end.begin.line;
+        ushort column = end.begin.column;
+        std::size_t pos = blob.size();
+        blob.resize(pos + HEADER_ENTRY_SIZE + name.size());
+        blob[pos] = op;
+        std::memcpy(&blob[pos + 1], &value, sizeof(value));
+        blob[pos + 3] = (ubyte)name.size();
+        std::memcpy(&blob[pos + 4], &line, sizeof(line));
+        std::memcpy(&blob[pos + 8], &column, sizeof(column));
+        std::memcpy(&blob[pos + HEADER_ENTRY_SIZE], name.data(), name.size());
+        return true;
+    };
+
+    for (std::size_t i = 0; i < tokens.size(); ) {
+        if (kind(i) == tokenKinds_.newline) {
+            ++i;
+            continue;
+        }
+        if (kind(i) != tokenKinds_.period || kind(i + 1) != tokenKinds_.ident)
+            return false;
+        std::string_view dirName = atoms_.name(tokens[i + 1].value.as<Atom>());
+        i += 2;
+
+        if (dirName == "equ") {
+            if (kind(i) != tokenKinds_.ident || kind(i + 1) != tokenKinds_.comma
+                || kind(i + 2) != tokenKinds_.literal || kind(i + 3) != tokenKinds_.newline)
+                return false;
+            const Literal &literal = tokens[i + 2].value.as<Literal>();
+            if (literal.overflow
+                || !append(HDR_EQU, literal.value, atoms_.name(tokens[i].value.as<Atom>()), tokens[i + 3].location))
+                return false;
+            i += 4;
+        } else if (dirName == "extern" || dirName == "global") {
+            HeaderOp op = dirName == "extern" ? HDR_EXTERN : HDR_GLOBAL;
+            std::size_t first = i;
+            while (kind(i) == tokenKinds_.ident && kind(i + 1) == tokenKinds_.comma)
+                i += 2;
+            if (kind(i) != tokenKinds_.ident || kind(i + 1) != tokenKinds_.newline)
+                return false;
+            for (std::size_t j = first; j <= i; j += 2)
+                if (!append(op, 0, atoms_.name(tokens[j].value.as<Atom>()), tokens[i + 1].location))
+                    return false;
+            i += 2;
+        } else
+            return false;
+    }
+
+    return true;
+}
+
+int Assembler::loadHeader(const HeaderBlob &blob, const std::string& filename)
+{
+    ++stats_.precompiledHeaders;
+    dirString_ = std::string_view(); // the .include file name
+
+    // Located as if the header was included as tokens: at the line in the
+    // file, followed by the .include line
+    yy::location includer = location_;
+    includeNames_.push_back(filename);
+    location_.initialize(&includeNames_.back());
+    expansions_.push_back({ Tokens(), 0, 1, INCLUDE, MACRO_NONE, (uint)includer.begin.line });
+
+    int res = AE_OK;
+    for (std::size_t pos = 0; pos < blob.size(); ) {
+        HeaderOp op = (HeaderOp)blob[pos];
+        ushort value, column;
+        uint line;
+        std::memcpy(&value, &blob[pos + 1], sizeof(value));
+        std::memcpy(&line, &blob[pos + 4], sizeof(line));
+        std::memcpy(&column, &blob[pos + 8], sizeof(column));
+        std::string_view name((const char*)&blob[pos + HEADER_ENTRY_SIZE], blob[pos + 3]);
+        pos += HEADER_ENTRY_SIZE + name.size();
+
+        location_.begin.line = location_.end.line = line;
+        location_.begin.column = location_.end.column = column;
+        dirArgs_.clear();
+        dirArgs_.push_back(intern(name));
+        if (op == HDR_EQU)
+            dirArgs_.push_back(value);
+        if (dirFirstPass(HEADER_OP_DIRS[op]) != AE_OK)
+            res = AE_SYNTAX_NOSKIP;
+    }
+    dirArgs_.clear();
+
+    expansions_.pop_back();
+    location_ = includer;
+    return res;
+}
+
+void Assembler::endExpansions()
+{
+    if (!expansions_.empty()) {
+        expansions_.clear();
+        location_ = sourceLocation_;
+    }
+    pending_.clear();
+}
+
+int Assembler::instr(Atom instrAtom)
 {
-    if (sectionName_.empty()) {
+    std::string_view instrName = atoms_.name(instrAtom);
+
+    if (section_ == SECTION_NONE) {
         error("instruction not in any section");
         return AE_SYNTAX_NOSKIP;
     }
@@ -121,28 +692,28 @@ int Assembler::instr(std::string instrName)
         }
     }
 
-    int res;
-    if (pass_ == 0)
-        res = instrFirstPass(instrName);
-    else
-        res = instrSecondPass(instrName);
-    
+    IrRecord instrRecord(IR_INSTR);
+    int res = instrFirstPass(instrName, instrRecord);
+    if (res == AE_OK) {
+        ++stats_.instructions[INSTRUCTIONS.indexOf(atoms_.name(instrAtom))]; // push, not str
+        res = record(instrRecord);
+    }
+
     instrNumArgs_ = 0;
     labeled_ = false;
     pcRel_ = false;
 
     return res;
-
 }
-int Assembler::instrFirstPass(const std::string& instrName)
+int Assembler::instrFirstPass(std::string_view instrName, IrRecord &record)
 {
-    auto instrIt = INSTRUCTIONS.find(instrName);
-    if (instrIt == INSTRUCTIONS.end()) {
-        syntaxError("unknown instruction: " + instrName);
+    const InstrInfo *info = INSTRUCTIONS.find(instrName);
+    if (!info) {
+        syntaxError("unknown instruction: " + std::string(instrName));
         return AE_SYNTAX_NOSKIP;
     }
 
-    const InstrInfo& iInfo = instrIt->second;
+    const InstrInfo& iInfo = *info;
 
     if (iInfo.numArgs != instrNumArgs_) {
         syntaxError("instruction takes " + std::to_string(iInfo.numArgs)
@@ -150,17 +721,6 @@ int Assembler::instrFirstPass(const std::string& instrName)
         return AE_SYNTAX_NOSKIP;
     }
 
-    lc_++; // InstrDescr
-
-    if (iInfo.numArgs == 0) // instr
-        return AE_OK;
-
-    lc_++; // RegDescr
-
-    if (!(iInfo.argAddrModes[0] == REGDIR && iInfo.argAddrModes[1] == 0) // instr reg
-        && !(iInfo.argAddrModes[0] == REGDIR && iInfo.argAddrModes[1] == REGDIR)) // instr reg, reg
-        lc_++; // AddrMode
-
     for (ubyte i = 0; i < iInfo.numArgs; ++i) {
         InstrArg& arg = instrArgs_[i];
 
@@ -189,55 +749,30 @@ int Assembler::instrFirstPass(const std::string& instrName)
                         + (i == 0 ? "first" : "second") + " operand");
             return AE_SYNTAX_NOSKIP;
         }
-
-        string_ushort_variant *payload = nullptr;
-
-        switch(arg.addrMode) {
-        case IMMED:
-            lc_ += 2; // DataHigh + DataLow
-            payload = &arg.val;
-            break;
-        case MEMDIR:
-            lc_ += 2; // DataHigh + DataLow
-            payload = &arg.val;
-            break;
-        case REGDIR_OFFSET:
-            lc_ += 2; // DataHigh + DataLow
-            payload = &arg.off;
-            break;
-        case REGIND_OFFSET:
-            lc_ += 2; // DataHigh + DataLow
-            payload = &arg.off;
-            break;
-        }
-
-        if (payload) {
-            std::string* symbolName = std::get_if<std::string>(payload);
-            if (symbolName)
-                getSymbol(*symbolName).used = true;
-        }
     }
 
-    return AE_OK;
-}
-int Assembler::instrSecondPass(const std::string& instrName)
-{
-    const InstrInfo& iInfo = INSTRUCTIONS.find(instrName)->second;
+    record.code[0] = iInfo.opCode; // InstrDescr
+    record.size = 1;
 
-    section_->data.push_back(iInfo.opCode); // InstrDescr
-    if (iInfo.numArgs == 0) // instr
+    if (iInfo.numArgs == 0) { // instr
+        lc_ += record.size;
         return AE_OK;
+    }
+
+    record.size = 2;
 
     if (iInfo.argAddrModes[0] == REGDIR && iInfo.argAddrModes[1] == 0) { // instr reg
         ubyte regD = *std::get_if<ushort>(&instrArgs_[0].val);
-        section_->data.push_back(regD << 4 | 0xF); // RegDescr
+        record.code[1] = regD << 4 | 0xF; // RegDescr
+        lc_ += record.size;
         return AE_OK;
     }
 
     if (iInfo.argAddrModes[0] == REGDIR && iInfo.argAddrModes[1] == REGDIR) { // instr reg, reg
         ubyte regD = *std::get_if<ushort>(&instrArgs_[0].val);
         ubyte regS = *std::get_if<ushort>(&instrArgs_[1].val);
-        section_->data.push_back(regD << 4 | regS); // RegDescr
+        record.code[1] = regD << 4 | regS; // RegDescr
+        lc_ += record.size;
         return AE_OK;
     }
 
@@ -245,28 +780,14 @@ int Assembler::instrSecondPass(const std::string& instrName)
 
     InstrArg *op = &instrArgs_[0];
     ubyte regD = 0xFu, regS = 0xFu;
-    ubyte addrMode;
+    ubyte addrMode = AM_IMMED;
 
     if (iInfo.argAddrModes[0] == REGDIR) { // instr regD, op
         regD = *std::get_if<ushort>(&instrArgs_[0].val);
         op = &instrArgs_[1];
     }
 
-    if (op->addrMode == (MEMDIR | IMMED)) { // ambiguous syntax
-        if (iInfo.jmpSyntax)
-            op->addrMode = IMMED; // jmp <lit/sym>
-        else
-            op->addrMode = MEMDIR; // instr <lit/sym>
-    }
-
-    if (op->addrMode == (REGIND_OFFSET | REGDIR_OFFSET) && pcRel_) { // pc rel
-        if (iInfo.jmpSyntax)
-            op->addrMode = REGDIR_OFFSET; // jmp %<symbol>
-        else
-            op->addrMode = REGIND_OFFSET; // instr %<symbol>
-    }
-
-    string_ushort_variant *payload = nullptr;
+    operand_variant *payload = nullptr;
 
     switch(op->addrMode) {
     case IMMED:
@@ -297,19 +818,37 @@ int Assembler::instrSecondPass(const std::string& instrName)
         break;
     }
 
-    section_->data.push_back(regD << 4 | regS); // RegDescr
-    section_->data.push_back(regIndUpdate_ << 4 | addrMode); // AddrMode
+    record.code[1] = regD << 4 | regS; // RegDescr
+    record.code[2] = regIndUpdate_ << 4 | addrMode; // AddrMode
+    record.size = 3;
 
-    // dataHigh + dataLow
-    if (payload) {
-        int res = processWord(*payload, true);
-        if (res != AE_OK)
-            return res;
+    if (payload) { // DataHigh + DataLow
+        record.pcRel = pcRel_;
+        record.arg = irWords_.size();
+        irWords_.push_back(irWord(*payload));
+        record.size += 2;
     }
 
+    lc_ += record.size;
+
     return AE_OK;
 }
-int Assembler::instrArgImmed(string_ushort_variant arg)
+int Assembler::instrSecondPass(const IrRecord &record, SectionEncoder &encoder)
+{
+    std::size_t codeSize = record.size < 3 ? record.size : 3;
+    std::memcpy(encoder.emit(codeSize), record.code, codeSize);
+
+    if (record.size < 5)
+        return AE_OK;
+
+    // dataHigh + dataLow
+    encoder.pcRel = record.pcRel;
+    int res = processWord(irWords_[record.arg], true, encoder);
+    encoder.pcRel = false;
+
+    return res;
+}
+int Assembler::instrArgImmed(operand_variant arg)
 {
     instrArgs_[instrNumArgs_].jmpSyntax = false;
     instrArgs_[instrNumArgs_].addrMode = IMMED;
@@ -317,7 +856,7 @@ int Assembler::instrArgImmed(string_ushort_variant arg)
     instrNumArgs_++;
     return AE_OK;
 }
-int Assembler::instrArgMemDirOrJmpImmed(string_ushort_variant arg, bool jmpSyntax)
+int Assembler::instrArgMemDirOrJmpImmed(operand_variant arg, bool jmpSyntax)
 {
     instrArgs_[instrNumArgs_].jmpSyntax = jmpSyntax;
     instrArgs_[instrNumArgs_].addrMode = MEMDIR;
@@ -327,7 +866,7 @@ int Assembler::instrArgMemDirOrJmpImmed(string_ushort_variant arg, bool jmpSynta
     instrNumArgs_++;
     return AE_OK;
 }
-int Assembler::instrArgPCRel(const std::string& sym)
+int Assembler::instrArgPCRel(Atom sym)
 {
     instrArgs_[instrNumArgs_].addrMode = REGIND_OFFSET | REGDIR_OFFSET;
     instrArgs_[instrNumArgs_].val = PC_REGISTER;
@@ -336,44 +875,44 @@ int Assembler::instrArgPCRel(const std::string& sym)
     pcRel_ = true;
     return AE_OK;
 }
-int Assembler::instrArgRegDir(const std::string& reg, bool jmpSyntax)
+int Assembler::instrArgRegDir(Atom reg, bool jmpSyntax)
 {
-    auto regIt = REGISTERS.find(reg);
-    ubyte regNum = (regIt == REGISTERS.end()) ? (ubyte)NUM_REGISTERS : regIt->second;
+    const ubyte *regEntry = REGISTERS.find(atoms_.name(reg));
+    ubyte regNum = regEntry ? *regEntry : (ubyte)NUM_REGISTERS;
 
     instrArgs_[instrNumArgs_].jmpSyntax = jmpSyntax;
     instrArgs_[instrNumArgs_].addrMode = REGDIR;
     instrArgs_[instrNumArgs_].val = regNum;
     instrNumArgs_++;
 
-    if (regIt == REGISTERS.end()) {
-        syntaxError("invalid register: " + reg);
+    if (!regEntry) {
+        syntaxError("invalid register: " + std::string(atoms_.name(reg)));
         return AE_SYNTAX_NOSKIP;
     }
 
     return AE_OK;
 }
-int Assembler::instrArgRegInd(const std::string& reg, bool jmpSyntax)
+int Assembler::instrArgRegInd(Atom reg, bool jmpSyntax)
 {
-    auto regIt = REGISTERS.find(reg);
-    ubyte regNum = (regIt == REGISTERS.end()) ? (ubyte)NUM_REGISTERS : regIt->second;
+    const ubyte *regEntry = REGISTERS.find(atoms_.name(reg));
+    ubyte regNum = regEntry ? *regEntry : (ubyte)NUM_REGISTERS;
 
     instrArgs_[instrNumArgs_].jmpSyntax = jmpSyntax;
     instrArgs_[instrNumArgs_].addrMode = REGIND;
     instrArgs_[instrNumArgs_].val = regNum;
     instrNumArgs_++;
 
-    if (regIt == REGISTERS.end()) {
-        syntaxError("invalid register: " + reg);
+    if (!regEntry) {
+        syntaxError("invalid register: " + std::string(atoms_.name(reg)));
         return AE_SYNTAX_NOSKIP;
     }
 
     return AE_OK;
 }
-int Assembler::instrArgRegIndOff(const std::string& reg, string_ushort_variant off, bool jmpSyntax)
+int Assembler::instrArgRegIndOff(Atom reg, operand_variant off, bool jmpSyntax)
 {
-    auto regIt = REGISTERS.find(reg);
-    ubyte regNum = (regIt == REGISTERS.end()) ? (ubyte)NUM_REGISTERS : regIt->second;
+    const ubyte *regEntry = REGISTERS.find(atoms_.name(reg));
+    ubyte regNum = regEntry ? *regEntry : (ubyte)NUM_REGISTERS;
 
     instrArgs_[instrNumArgs_].jmpSyntax = jmpSyntax;
     instrArgs_[instrNumArgs_].addrMode = REGIND_OFFSET;
@@ -381,44 +920,46 @@ int Assembler::instrArgRegIndOff(const std::string& reg, string_ushort_variant o
     instrArgs_[instrNumArgs_].off = off;
     instrNumArgs_++;
 
-    if (regIt == REGISTERS.end()) {
-        syntaxError("invalid register: " + reg);
+    if (!regEntry) {
+        syntaxError("invalid register: " + std::string(atoms_.name(reg)));
         return AE_SYNTAX_NOSKIP;
     }
 
     return AE_OK;
 }
 
-int Assembler::dir(const std::string& dirName)
+int Assembler::dir(Atom dirName)
 {
-    int res;
-    if (pass_ == 0)
-        res = dirFirstPass(dirName);
-    else
-        res = dirSecondPass(dirName);
+    int res = dirFirstPass(atoms_.name(dirName));
 
     dirArgs_.clear();
+    dirString_ = std::string_view();
     labeled_ = false;
 
     return res;
 }
-int Assembler::dirFirstPass(const std::string& dirName)
+int Assembler::dirFirstPass(std::string_view dirName)
 {
-    auto dirIt = DIRECTIVES.find(dirName);
-    if (dirIt == DIRECTIVES.end()) {
-        syntaxError("unknown directive: " + dirName);
+    const DirInfo *info = DIRECTIVES.find(dirName);
+    if (!info) {
+        syntaxError("unknown directive: " + std::string(dirName));
         return AE_SYNTAX_NOSKIP;
     }
 
-    const DirInfo& dInfo = dirIt->second;
+    const DirInfo& dInfo = *info;
 
-    if (dInfo.sectionRequired && sectionName_.empty()) {
-        syntaxError("directive not in any section: " + dirName);
+    if (dInfo.sectionRequired && section_ == SECTION_NONE) {
+        syntaxError("directive not in any section: " + std::string(dirName));
         return AE_SYNTAX_NOSKIP;
     }
 
     if (!dInfo.labelsAllowed && labeled_) {
-        syntaxError("directive doesn't support labels: " + dirName);
+        syntaxError("directive doesn't support labels: " + std::string(dirName));
+        return AE_SYNTAX_NOSKIP;
+    }
+
+    if (dirString_.data() && dInfo.argFormat != STR_LIT_LIST) {
+        syntaxError("unexpected string, expected directive syntax: ." + std::string(dirName));
         return AE_SYNTAX_NOSKIP;
     }
 
@@ -426,62 +967,76 @@ int Assembler::dirFirstPass(const std::string& dirName)
     switch(dInfo.argFormat) {
     case NONE:
         if (!dirArgs_.empty()) {
-            syntaxError("expected directive syntax: ." + dirName);
+            syntaxError("expected directive syntax: ." + std::string(dirName));
             return AE_SYNTAX_NOSKIP;
         }
         break;
     case SYM:
-        if (dirArgs_.size() != 1 || !std::get_if<std::string>(&dirArgs_[0])) {
-            syntaxError("expected directive syntax: ." + dirName + " <IDENT>");
+        if (dirArgs_.size() != 1 || !std::get_if<Atom>(&dirArgs_[0])) {
+            syntaxError("expected directive syntax: ." + std::string(dirName) + " <IDENT>");
             return AE_SYNTAX_NOSKIP;
         }
         break;
     case LIT:
         if (dirArgs_.size() != 1 || !std::get_if<ushort>(&dirArgs_[0])) {
-            syntaxError("expected directive syntax: ." + dirName + " <LITERAL>");
+            syntaxError("expected directive syntax: ." + std::string(dirName) + " <LITERAL>");
             return AE_SYNTAX_NOSKIP;
         }
         break;
-    case SYM_LIT:
-        if (dirArgs_.size() != 2 || !std::get_if<std::string>(&dirArgs_[0]) || !std::get_if<ushort>(&dirArgs_[1])) {
-            syntaxError("expected directive syntax: ." + dirName + " <IDENT>, <LITERAL>");
+    case SYM_EXPR:
+        if (dirArgs_.size() != 2 || !std::get_if<Atom>(&dirArgs_[0])) {
+            syntaxError("expected directive syntax: ." + std::string(dirName) + " <IDENT>, <EXPRESSION>");
             return AE_SYNTAX_NOSKIP;
         }
         break;
     case SYM_LIST:
         if (dirArgs_.empty()) {
-            syntaxError("expected directive syntax: ." + dirName + " <IDENT list>");
+            syntaxError("expected directive syntax: ." + std::string(dirName) + " <IDENT list>");
             return AE_SYNTAX_NOSKIP;
         }
         for (uint i = 0; i < dirArgs_.size(); ++i) {
-            if (!std::get_if<std::string>(&dirArgs_[i])) {
-                syntaxError("unexpected " + std::to_string(std::get<ushort>(dirArgs_[i])) + ", expected directive syntax: ." + dirName + " <IDENT list>");
+            if (!std::get_if<Atom>(&dirArgs_[i])) {
+                const ushort *literal = std::get_if<ushort>(&dirArgs_[i]);
+                syntaxError("unexpected " + (literal ? std::to_string(*literal) : std::string("expression"))
+                            + ", expected directive syntax: ." + std::string(dirName) + " <IDENT list>");
                 return AE_SYNTAX_NOSKIP;
             }
         }
         break;
     case SYM_LIT_LIST:
         if (dirArgs_.empty()) {
-            syntaxError("expected directive syntax: ." + dirName + " <IDENT/LITERAL list>");
+            syntaxError("expected directive syntax: ." + std::string(dirName) + " <IDENT/LITERAL list>");
             return AE_SYNTAX_NOSKIP;
         }
         break;
+    case STR_LIT_LIST:
+        if (!dirString_.data()) {
+            syntaxError("expected directive syntax: ." + std::string(dirName) + " <STRING>, <LITERAL list>");
+            return AE_SYNTAX_NOSKIP;
+        }
+        for (uint i = 0; i < dirArgs_.size(); ++i) {
+            if (!std::get_if<ushort>(&dirArgs_[i])) {
+                syntaxError("expected directive syntax: ." + std::string(dirName) + " <STRING>, <LITERAL list>");
+                return AE_SYNTAX_NOSKIP;
+            }
+        }
+        break;
     }
 
+    ++stats_.directives[dInfo.dir];
+
     // Directives
     switch (dInfo.dir) {
     case GLOBAL:
         for (uint i = 0; i < dirArgs_.size(); ++i) {
-            const std::string &symbolName = std::get<std::string>(dirArgs_[i]);
-            Symbol &symbol = getSymbol(symbolName);
+            Symbol &symbol = getSymbol(std::get<Atom>(dirArgs_[i]));
             symbol.global = true;
         }
         break;
 
     case EXTERN:
         for (uint i = 0; i < dirArgs_.size(); ++i) {
-            const std::string &symbolName = std::get<std::string>(dirArgs_[i]);
-            Symbol &symbol = getSymbol(symbolName);
+            Symbol &symbol = getSymbol(std::get<Atom>(dirArgs_[i]));
             symbol.external = true;
         }
         break;
@@ -489,208 +1044,831 @@ int Assembler::dirFirstPass(const std::string& dirName)
     case SECTION: {
         endSection(); // end previous section
 
-        sectionName_ = SECTION_PREFIX + std::get<std::string>(dirArgs_[0]);
-        relSectionName_ = sectionName_ + REL_SUFFIX;
-
-        auto sit = sections_.find(sectionName_);
-        if (sit != sections_.end()) {
-            error("section with the same name already declared in this file: " + sectionName_);
+        // The only name lookup of a section
+        std::string sectionName = SECTION_PREFIX + std::string(atoms_.name(std::get<Atom>(dirArgs_[0])));
+        Atom sectionAtom = intern(sectionName);
+        if (sectionAtom >= sectionByName_.size())
+            sectionByName_.resize(atoms_.size(), SECTION_NONE);
+        if (sectionByName_[sectionAtom] != SECTION_NONE) {
+            error("section with the same name already declared in this file: " + sectionName);
             return AE_SYNTAX_NOSKIP;
         }
 
-        initRelSection();
+        // Data section followed by its relocation section
+        section_ = sectionByName_[sectionAtom] = sections_.size();
+        sections_.emplace_back(ST_DATA, sectionAtom).rel = section_ + 1;
+        sections_.emplace_back(ST_REL, intern(sectionName + REL_SUFFIX));
+        sectionOrder_.push_back(section_);
 
-        section_ = &sections_[sectionName_];
-        relSection_ = &sections_[relSectionName_];
-
-        section_->entry.type = ST_DATA;
-
-        break;
+        return record(IrRecord(IR_SECTION, section_));
     }
 
-    case WORD:
+    case WORD: {
         lc_ += dirArgs_.size() * 2;
-        for (uint i = 0; i < dirArgs_.size(); ++i) {
-            std::string* symbolName = std::get_if<std::string>(&dirArgs_[i]);
-            if (symbolName)
-                getSymbol(*symbolName).used = true;
-        }
+        IrRecord wordRecord(IR_WORD, irWords_.size(), dirArgs_.size());
+        for (uint i = 0; i < dirArgs_.size(); ++i)
+            irWords_.push_back(irWord(dirArgs_[i]));
 
-        break;
+        return record(wordRecord);
+    }
 
     case SKIP:
         lc_ += std::get<ushort>(dirArgs_[0]);
-        break;
+        return record(IrRecord(IR_SKIP, std::get<ushort>(dirArgs_[0])));
 
     case EQU: {
-        const std::string &symbolName = std::get<std::string>(dirArgs_[0]);
-        ushort literal = std::get<ushort>(dirArgs_[1]);
-        Symbol &symbol = getSymbol(symbolName);
-        if (symbol.defined()) {
-            error("symbol already defined: " + symbolName);
+        Atom symbolName = std::get<Atom>(dirArgs_[0]);
+        uint symbolIdx = symbolIndex(symbolName);
+        if (symbols_[symbolIdx].defined()) {
+            error("symbol already defined: " + std::string(atoms_.name(symbolName)));
+            return AE_SYNTAX_NOSKIP;
+        }
+
+        // Symbols and expressions may use anything defined up to .end,
+        // they are resolved there
+        uint expr = EXPR_NONE;
+        if (!std::get_if<ushort>(&dirArgs_[1]))
+            expr = exprNode(dirArgs_[1]);
+
+        Symbol &symbol = symbols_[symbolIdx];
+        symbol.external = false;
+        symbol.entry.type = SYMT_ABS;
+        if (expr == EXPR_NONE)
+            symbol.entry.value = std::get<ushort>(dirArgs_[1]);
+        else {
+            symbol.equ = equs_.size();
+            equs_.push_back({ symbolIdx, expr, (uint)location_.begin.line, fileIndex(location_.begin.filename),
+                              (ushort)location_.begin.column, false });
+        }
+        break;
+    }
+
+    case INCBIN: {
+        // .incbin "file"[, offset[, length]]: the file is mapped until the
+        // end of the run and its bytes copied to the section in pass 1
+        if (dirArgs_.size() > 2) {
+            syntaxError("expected directive syntax: .incbin <STRING>[, <offset>[, <length>]]");
+            return AE_SYNTAX_NOSKIP;
+        }
+        std::string filename;
+        if (!sourcePath(dirString_, filename))
+            return AE_SYNTAX_NOSKIP;
+        std::unique_ptr<MappedFile> file = std::make_unique<MappedFile>();
+        if (!file->open(filename)) {
+            error("cannot open file: " + filename);
+            return AE_SYNTAX_NOSKIP;
+        }
+        std::size_t offset = dirArgs_.empty() ? 0 : std::get<ushort>(dirArgs_[0]);
+        if (offset > file->size()) {
+            error("offset past the end of file: " + filename);
+            return AE_SYNTAX_NOSKIP;
+        }
+        std::size_t size = file->size() - offset;
+        if (dirArgs_.size() > 1) {
+            if (std::get<ushort>(dirArgs_[1]) > size) {
+                error("length past the end of file: " + filename);
+                return AE_SYNTAX_NOSKIP;
+            }
+            size = std::get<ushort>(dirArgs_[1]);
+        }
+        if (size > 0xFFFFu) { // more than a section holds
+            error("file too large (" + std::to_string(size) + " bytes): " + filename);
+            return AE_SYNTAX_NOSKIP;
+        }
+
+        externalInputs_ = true;
+        lc_ += size;
+        irBlobs_.push_back({ file->data() + offset, (uint)size });
+        mappedFiles_.push_back(std::move(file));
+        return record(IrRecord(IR_BLOB, irBlobs_.size() - 1));
+    }
+
+    case INCLUDE: {
+        if (!dirArgs_.empty()) {
+            syntaxError("expected directive syntax: .include <STRING>");
+            return AE_SYNTAX_NOSKIP;
+        }
+        std::string filename;
+        if (!sourcePath(dirString_, filename))
+            return AE_SYNTAX_NOSKIP;
+        externalInputs_ = true;
+        return include(filename);
+    }
+
+    case REPT: {
+        // The body is read here and given to the parser count times
+        yy::location start = location_;
+        Expansion expansion{ Tokens(), 0, std::get<ushort>(dirArgs_[0]), REPT, MACRO_NONE, (uint)start.begin.line };
+        if (!captureBody(expansion.tokens, ENDR)) {
+            error_ = true;
+            report(DIAG_SYNTAX_ERROR, start, "missing .endr");
+            return AE_SYNTAX_NOSKIP;
+        }
+        if (expansions_.size() >= MAX_EXPANSION_DEPTH) {
+            error_ = true;
+            report(DIAG_SYNTAX_ERROR, start, "macro expansion too deep: .rept");
             return AE_SYNTAX_NOSKIP;
-        } else { // symbol definition
-            symbol.external = false;
-            symbol.entry.type = SYMT_ABS;
-            symbol.entry.value = literal;
         }
+        pushExpansion(std::move(expansion));
         break;
     }
 
+    case ENDR:
+    case ENDM:
+        syntaxError("." + std::string(dirName) + " without " + (dInfo.dir == ENDR ? ".rept" : ".macro"));
+        return AE_SYNTAX_NOSKIP;
+
+    case MACRO: // taken out before the parser at the start of a line
+        break;
+
     case END:
+        endExpansions(); // nothing after .end is assembled
         endSection();
+        resolveEqus();
+        if (options_.optimize && !options_.singlePass && !error_)
+            optimize();
         fillSymbolTable();
+        if (!error_)
+            record(IrRecord(IR_END));
         return AE_END;
     }
 
     return AE_OK;
 }
-int Assembler::dirSecondPass(const std::string& dirName)
+int Assembler::dirSecondPass(const IrRecord &record, SectionEncoder &encoder)
 {
-    const DirInfo& dInfo = DIRECTIVES.find(dirName)->second;
+    switch (record.op) {
+    case IR_SECTION: // single pass only, the second pass splits the IR at sections
+        encoder = SectionEncoder();
+        encoder.section = &sections_[record.arg]; // opened by the first pass
+        encoder.relSection = &sections_[encoder.section->rel];
+        break;
 
-    // Directives
-    switch (dInfo.dir) {
-    case GLOBAL:
-    case EXTERN:
-    case EQU:
+    case IR_WORD:
+        for (uint i = 0; i < record.count; ++i) {
+            int res = processWord(irWords_[record.arg + i], false, encoder);
+            if (res != AE_OK)
+                return res;
+        }
         break;
-        
-    case SECTION: {
-        endSection();
 
-        sectionName_ = SECTION_PREFIX + std::get<std::string>(dirArgs_[0]);
-        relSectionName_ = sectionName_ + REL_SUFFIX;
+    case IR_SKIP: // already zero, allocated only if data follows
+        encoder.size += record.arg;
+        break;
 
-        section_ = &sections_[sectionName_];
-        relSection_ = &sections_[relSectionName_];
+    case IR_BLOB: {
+        const IrBlob &blob = irBlobs_[record.arg];
+        std::memcpy(encoder.emit(blob.size), blob.data, blob.size);
+        break;
+    }
 
-        section_->data = std::move(sectionDataCache_);
-        relSection_->data = std::move(relSectionDataCache_);
+    case IR_END: // single pass only
+        if (patchFixups() == AE_OK) {
+            layoutDataSections();
+            endObjFile();
+        }
+        return AE_END;
 
+    case IR_INSTR:
         break;
     }
 
-    case WORD:
-        for (uint i = 0; i < dirArgs_.size(); ++i) {
-            int res = processWord(dirArgs_[i], false);
-            if (res != AE_OK)
-                return res;
+    return AE_OK;
+}
+void Assembler::secondPass()
+{
+    // Data section sizes are known after the first pass, the output is
+    // sized up to them and sections are encoded in their final location
+    layoutDataSections();
+    out_.resize(outSize_);
+
+    // Label values are known too, so every section's records can be
+    // encoded on their own
+    std::vector<SectionEncoder> encoders;
+    std::size_t symbolWords = 0; // in the current section, bounds its relocations
+    for (uint i = 0; i < ir_.size(); ++i) {
+        const IrRecord &record = ir_[i];
+        if (record.op == IR_INSTR && record.size == 5)
+            symbolWords += !irWords_[record.arg].literal();
+        else if (record.op == IR_WORD) {
+            for (uint w = 0; w < record.count; ++w)
+                symbolWords += !irWords_[record.arg + w].literal();
         }
-        break;
+        if (record.op != IR_SECTION && record.op != IR_END)
+            continue;
 
-    case SKIP:
-        section_->data.resize(section_->data.size() + std::get<ushort>(dirArgs_[0]));
-        break;
+        // Relocation data is reserved up front: the arena grows without
+        // leftovers and workers never allocate from it
+        if (!encoders.empty()) {
+            encoders.back().end = i;
+            encoders.back().relSection->data.reserve(symbolWords * sizeof(RelEntry));
+        }
+        symbolWords = 0;
+        if (record.op == IR_END)
+            break;
 
-    case END:
-        endSection();
-        endSymbolTable();
-        endStrSection();
-        endSectionHeaderTable();
-        writeObjHeader();
-        return AE_END;
+        SectionEncoder &encoder = encoders.emplace_back();
+        encoder.section = &sections_[record.arg];
+        encoder.relSection = &sections_[encoder.section->rel];
+        encoder.out = out_.data() + encoder.section->entry.dataOffset;
+        encoder.begin = i + 1;
     }
 
-    return AE_OK;
+    unsigned workers = std::min<std::size_t>(options_.sectionJobs, encoders.size());
+    if (workers > 1 && ir_.size() >= PARALLEL_MIN_RECORDS) {
+        // Largest sections first so the tail is made of small ones
+        std::vector<uint> order(encoders.size());
+        for (uint i = 0; i < order.size(); ++i)
+            order[i] = i;
+        std::stable_sort(order.begin(), order.end(), [&encoders](uint a, uint b) {
+            return encoders[a].section->entry.size > encoders[b].section->entry.size;
+        });
+
+        std::atomic<std::size_t> next(0);
+        std::vector<double> workerCpu(workers); // the calling thread's is in its phase time
+        auto worker = [&](unsigned w) {
+            double cpu = threadCpuSeconds();
+            std::size_t i;
+            while ((i = next.fetch_add(1, std::memory_order_relaxed)) < order.size())
+                encodeSection(encoders[order[i]]);
+            workerCpu[w] = threadCpuSeconds() - cpu;
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(workers - 1);
+        for (unsigned w = 1; w < workers; ++w)
+            threads.emplace_back(worker, w);
+        worker(0);
+        for (std::thread &thread : threads)
+            thread.join();
+        for (unsigned w = 1; w < workers; ++w)
+            stats_.cpu[PHASE_ENCODE] += workerCpu[w];
+    } else {
+        for (SectionEncoder &encoder : encoders)
+            encodeSection(encoder);
+    }
+
+    int res = AE_OK;
+    for (SectionEncoder &encoder : encoders)
+        if (stitchSection(encoder) != AE_OK)
+            res = AE_SYNTAX_NOSKIP;
+
+    if (res == AE_OK)
+        endObjFile();
 }
-int Assembler::dirArg(string_ushort_variant arg)
+void Assembler::optimize()
 {
-    dirArgs_.push_back(arg);
-    return AE_OK;
+    // push and pop are encoded as str and ldr with an updating [sp]
+    constexpr ubyte pushOp = INSTRUCTIONS.find("push")->opCode, popOp = INSTRUCTIONS.find("pop")->opCode;
+    static_assert(pushOp == INSTRUCTIONS.find("str")->opCode && popOp == INSTRUCTIONS.find("ldr")->opCode);
+    constexpr ubyte pushMode = REGIND_PRE_DEC << 4 | AM_REGIND, popMode = REGIND_POST_INC << 4 | AM_REGIND;
+    constexpr ubyte callOp = INSTRUCTIONS.find("call")->opCode;
+    constexpr ubyte jmpOp = INSTRUCTIONS.find("jmp")->opCode, jgtOp = INSTRUCTIONS.find("jgt")->opCode;
+    static_assert(INSTRUCTIONS.find("jeq")->opCode == jmpOp + 1 && INSTRUCTIONS.find("jne")->opCode == jmpOp + 2
+                  && jgtOp == jmpOp + 3, "jmp..jgt are tested as a range");
+
+    // call or jump with a 16 bit operand, absolute or PC relative
+    auto jump = [](const IrRecord &record) {
+        ubyte op = record.code[0];
+        return record.op == IR_INSTR && (op == callOp || (op >= jmpOp && op <= jgtOp))
+            && record.size == 5 && ((record.code[2] & 0xF) == AM_IMMED || record.pcRel);
+    };
+
+    // Code can't move in sections whose labels are used with an offset
+    // (label + n), the offset would be stale
+    std::vector<bool> pinned(sections_.size());
+    auto pinOffsetLabel = [&](uint expr) {
+        ExprValue value;
+        std::string message;
+        if (evalExpr(expr, value, message) == AE_OK && !value.abs() && symbols_[value.symbol].label()
+            && value.value != symbols_[value.symbol].entry.value)
+            pinned[symbols_[value.symbol].section] = true;
+    };
+    for (const IrWord &word : irWords_)
+        if (word.expr != EXPR_NONE)
+            pinOffsetLabel(word.expr);
+    for (const EquDef &equ : equs_)
+        pinOffsetLabel(equ.expr);
+
+    // Label symbols by section. A .equ resolved to a label is left out:
+    // its value can lie anywhere, even outside the section, and it is
+    // resolved again at the end. Aliases with an offset pin the section.
+    std::vector<bool> equ(symbols_.size());
+    for (const EquDef &def : equs_)
+        equ[def.symbol] = true;
+    std::vector<std::vector<uint>> labels(sections_.size());
+    for (uint i = 0; i < symbols_.size(); ++i)
+        if (symbols_[i].label() && !equ[i])
+            labels[symbols_[i].section].push_back(i);
+
+    std::vector<uint> addresses; // of the records of the current section
+    std::vector<bool> labeled;
+    // Sections are contiguous in the IR, each starts with its IR_SECTION
+    for (uint begin = 0; begin < ir_.size(); ) {
+        uint sectionIndex = ir_[begin].arg;
+        Section &section = sections_[sectionIndex];
+        uint end = begin + 1;
+        while (end < ir_.size() && ir_[end].op != IR_SECTION)
+            ++end;
+
+        addresses.clear();
+        uint lc = 0;
+        for (uint i = begin + 1; i < end; ++i) {
+            addresses.push_back(lc);
+            const IrRecord &record = ir_[i];
+            lc += record.op == IR_INSTR ? record.size : record.op == IR_WORD ? record.count * 2
+                : record.op == IR_BLOB ? irBlobs_[record.arg].size : record.arg;
+        }
+        labeled.assign(lc + 1, false);
+        for (uint symbol : labels[sectionIndex])
+            labeled[symbols_[symbol].entry.value] = true;
+
+        // Instruction at a label of this section, nullptr if none
+        auto instrAt = [&](const IrWord &word) -> IrRecord* {
+            if (word.symbol == SYMBOL_NONE || !symbols_[word.symbol].label()
+                || symbols_[word.symbol].section != sectionIndex)
+                return nullptr;
+            ushort address = symbols_[word.symbol].entry.value;
+            auto it = std::lower_bound(addresses.begin(), addresses.end(), address);
+            for (; it != addresses.end() && *it == address; ++it) {
+                IrRecord &record = ir_[begin + 1 + (it - addresses.begin())];
+                if (record.op == IR_INSTR)
+                    return &record;
+            }
+            return nullptr;
+        };
+
+        // Jumps to an unconditional jump of the same kind go to its target
+        // (a few hops, cycles stop at the jump itself)
+        for (uint i = begin + 1; i < end; ++i) {
+            IrRecord &record = ir_[i];
+            if (!jump(record))
+                continue;
+            IrWord &word = irWords_[record.arg];
+            bool threaded = false;
+            for (int hops = 0; hops < 8; ++hops) {
+                const IrRecord *target = instrAt(word);
+                if (!target || target == &record || !jump(*target) || target->code[0] != jmpOp
+                    || target->pcRel != record.pcRel || target->code[2] != record.code[2])
+                    break;
+                const IrWord &targetWord = irWords_[target->arg];
+                if (targetWord.symbol == word.symbol && targetWord.expr == EXPR_NONE)
+                    break; // jumps to itself
+                if (record.pcRel && (targetWord.expr != EXPR_NONE || !instrAt(targetWord)))
+                    break; // would need a relocation it doesn't have now
+                word.symbol = targetWord.symbol;
+                word.expr = targetWord.expr;
+                word.value = targetWord.value;
+                threaded = true;
+            }
+            stats_.threadedJumps += threaded;
+        }
+
+        // push rX, pop rX (no label in between) leave registers and the
+        // stack pointer as they were
+        std::vector<std::pair<uint, uint>> removed; // address, bytes removed up to it (included)
+        if (!pinned[sectionIndex]) {
+            for (uint i = begin + 1; i + 1 < end; ++i) {
+                IrRecord &push = ir_[i], &pop = ir_[i + 1];
+                ubyte reg = push.code[1] >> 4;
+                if (push.op != IR_INSTR || pop.op != IR_INSTR || push.size != 3 || pop.size != 3
+                    || push.code[0] != pushOp || push.code[2] != pushMode
+                    || pop.code[0] != popOp || pop.code[2] != popMode
+                    || (push.code[1] & 0xF) != SP_REGISTER || push.code[1] != pop.code[1]
+                    || reg == SP_REGISTER || reg == PC_REGISTER || labeled[addresses[i + 1 - begin - 1]])
+                    continue;
+                uint before = removed.empty() ? 0 : removed.back().second;
+                removed.push_back({ addresses[i - begin - 1], before + push.size + pop.size });
+                push.size = pop.size = 0; // encodes to nothing
+                stats_.removedInstructions += 2;
+                ++i;
+            }
+        }
+
+        begin = end;
+        if (removed.empty())
+            continue;
+
+        // Addresses move down by the bytes removed before them
+        auto remap = [&removed](uint address) {
+            auto it = std::lower_bound(removed.begin(), removed.end(), std::make_pair(address, 0u));
+            return it == removed.begin() ? address : address - (it - 1)->second;
+        };
+        for (uint symbol : labels[sectionIndex])
+            symbols_[symbol].entry.value = remap(symbols_[symbol].entry.value);
+        SectionEntry &entry = sectionHeaderTable_[section.id];
+        entry.size = section.entry.size = remap(section.entry.size);
+        if (section.entry.flags & SF_ZERO_FILL)
+            entry.fileSize = section.entry.fileSize = remap(section.entry.fileSize);
+    }
+
+    // .equ values computed from labels follow them
+    for (uint i = 0; i < equs_.size(); ++i) {
+        Symbol &symbol = symbols_[equs_[i].symbol];
+        symbol.equ = i;
+        symbol.entry.type = SYMT_ABS;
+    }
+    resolveEqus();
 }
 
-int Assembler::label(const std::string& label)
+void Assembler::encodeSection(SectionEncoder &encoder)
+{
+    // Errors are collected in the encoder and reported by stitchSection
+    for (uint i = encoder.begin; i < encoder.end; ++i) {
+        const IrRecord &record = ir_[i];
+        if (record.op == IR_INSTR)
+            instrSecondPass(record, encoder);
+        else
+            dirSecondPass(record, encoder);
+    }
+}
+int Assembler::stitchSection(SectionEncoder &encoder)
+{
+    for (const WordError &wordError : encoder.errors) // report at the reference
+        errorAt(wordError.word->file, wordError.word->line, wordError.word->column, wordError.message);
+
+    for (std::size_t t = 0; t < NUM_REL_TYPES; ++t)
+        stats_.relocations[t] += encoder.relocations[t];
+    stats_.resolvedPcRelocations += encoder.resolvedPcRelocations;
+
+    // Section symbols enter the symbol table in reference order
+    for (const SectionSymbolRef &ref : encoder.sectionRefs) {
+        ushort symbolId = getSectionSymbol(ref.section).id;
+        std::memcpy(&encoder.relSection->data[ref.relOffset + offsetof(RelEntry, symbolId)],
+                    &symbolId, sizeof(symbolId));
+    }
+
+    return encoder.errors.empty() ? AE_OK : AE_SYNTAX_NOSKIP;
+}
+
+int Assembler::record(const IrRecord &record)
+{
+    if (record.op == IR_INSTR || record.op == IR_WORD || record.op == IR_BLOB)
+        dataEnd_ = lc_; // lc_ includes the record
+
+    if (!options_.singlePass) {
+        ir_.push_back(record);
+        return AE_OK;
+    }
+
+    // single pass: encode right away
+    int res = record.op == IR_INSTR ? instrSecondPass(record, encoder_) : dirSecondPass(record, encoder_);
+    irWords_.clear();
+
+    return res == AE_END ? AE_OK : res;
+}
+
+IrWord Assembler::irWord(const operand_variant &arg)
+{
+    IrWord word;
+
+    if (const Atom *symbolName = std::get_if<Atom>(&arg)) {
+        word.symbol = symbolIndex(*symbolName);
+        symbols_[word.symbol].used = true;
+    } else if (const Expr *expr = std::get_if<Expr>(&arg))
+        word.expr = *expr;
+    else
+        word.value = std::get<ushort>(arg);
+
+    word.line = location_.begin.line;
+    word.file = fileIndex(location_.begin.filename);
+    word.column = location_.begin.column;
+
+    return word;
+}
+operand_variant Assembler::exprOp(ExprOp op, const operand_variant &left, const operand_variant &right)
 {
-    if (pass_ == 0) {
-        if (sectionName_.empty()) {
-            error("label not in any section: " + label);
+    const ushort *leftLiteral = std::get_if<ushort>(&left);
+    const ushort *rightLiteral = std::get_if<ushort>(&right);
+    if (leftLiteral && rightLiteral) {
+        if (op == EXPR_DIV && *rightLiteral == 0) {
+            syntaxError("division by zero");
+            return (ushort)0;
+        }
+        return applyExprOp(op, *leftLiteral, *rightLiteral);
+    }
+
+    ExprNode node{ op, exprNode(left), 0 };
+    if (op != EXPR_NEG)
+        node.right = exprNode(right);
+    exprs_.push_back(node);
+    return Expr(exprs_.size() - 1);
+}
+
+uint Assembler::exprNode(const operand_variant &arg)
+{
+    if (const Expr *expr = std::get_if<Expr>(&arg))
+        return *expr;
+
+    if (const Atom *symbolName = std::get_if<Atom>(&arg)) {
+        uint symbol = symbolIndex(*symbolName);
+        symbols_[symbol].used = true;
+        exprs_.push_back({ EXPR_SYMBOL, symbol, 0 });
+    } else
+        exprs_.push_back({ EXPR_LITERAL, std::get<ushort>(arg), 0 });
+
+    return exprs_.size() - 1;
+}
+
+int Assembler::evalExpr(uint node, ExprValue &value, std::string &message)
+{
+    const ExprNode &expr = exprs_[node];
+
+    if (expr.op == EXPR_LITERAL) {
+        value = ExprValue{ (ushort)expr.left, SYMBOL_NONE };
+        return AE_OK;
+    }
+
+    if (expr.op == EXPR_SYMBOL) {
+        const Symbol &symbol = symbols_[expr.left];
+        if (symbol.equ != EQU_NONE) {
+            EquDef &equ = equs_[symbol.equ];
+            if (equ.resolving) {
+                message = "circular .equ definition:";
+                auto it = std::find(equStack_.begin(), equStack_.end(), equ.symbol);
+                for (; it != equStack_.end(); ++it)
+                    message += " " + std::string(atoms_.name(symbols_[*it].name)) + " ->";
+                message += " " + std::string(atoms_.name(symbol.name));
+                return AE_SYNTAX_NOSKIP;
+            }
+            if (resolveEqu(symbol.equ) != AE_OK) {
+                message.clear(); // reported with the .equ
+                return AE_SYNTAX_NOSKIP;
+            }
+        }
+
+        if (symbol.external)
+            value = ExprValue{ 0, expr.left };
+        else if (symbol.label())
+            value = ExprValue{ symbol.entry.value, expr.left };
+        else if (symbol.abs())
+            value = ExprValue{ symbol.entry.value, SYMBOL_NONE };
+        else {
+            message = "undeclared symbol " + std::string(atoms_.name(symbol.name));
             return AE_SYNTAX_NOSKIP;
         }
-        Symbol &symbol = getSymbol(label);
-        if (symbol.defined()) {
-            error("symbol already defined: " + label);
+        return AE_OK;
+    }
+
+    ExprValue left, right;
+    if (evalExpr(expr.left, left, message) != AE_OK
+        || (expr.op != EXPR_NEG && evalExpr(expr.right, right, message) != AE_OK))
+        return AE_SYNTAX_NOSKIP;
+
+    // Relocatable values only move by an absolute amount, and differences
+    // of labels in one section are absolute
+    value.symbol = SYMBOL_NONE;
+    if (left.abs() && right.abs()) {
+        if (expr.op == EXPR_DIV && right.value == 0) {
+            message = "division by zero";
             return AE_SYNTAX_NOSKIP;
-        } else { // symbol definition
-            symbol.external = false;
-            symbol.section = sectionName_;
-            symbol.entry.type = SYMT_LABEL;
-            symbol.entry.value = (ushort)lc_;
-            labeled_ = true;
         }
-    } else
-        getSymbol(label).entry.sectionEntryId = section_->id;
+    } else if (expr.op == EXPR_ADD && (left.abs() || right.abs()))
+        value.symbol = left.abs() ? right.symbol : left.symbol;
+    else if (expr.op == EXPR_SUB && right.abs())
+        value.symbol = left.symbol;
+    else if (expr.op == EXPR_SUB && !left.abs()) {
+        const Symbol &leftSymbol = symbols_[left.symbol], &rightSymbol = symbols_[right.symbol];
+        if (!leftSymbol.label() || !rightSymbol.label() || leftSymbol.section != rightSymbol.section) {
+            message = "difference of symbols not in the same section";
+            return AE_SYNTAX_NOSKIP;
+        }
+    } else {
+        message = std::string("operator ") + EXPR_OP_NAMES[expr.op] + " on a relocatable value";
+        return AE_SYNTAX_NOSKIP;
+    }
 
+    value.value = applyExprOp(expr.op, left.value, right.value);
     return AE_OK;
 }
 
-int Assembler::processWord(string_ushort_variant &arg, bool instr)
+int Assembler::resolveEqu(uint index)
 {
-    ushort value;
-    ushort *literal = std::get_if<ushort>(&arg);
+    uint symbolIdx = equs_[index].symbol;
+    equs_[index].resolving = true;
+    equStack_.push_back(symbolIdx);
+
+    ExprValue value;
+    std::string message;
+    int res = evalExpr(equs_[index].expr, value, message);
+
+    equStack_.pop_back();
+    equs_[index].resolving = false;
+
+    // Absolute values and label offsets become the symbol value, a .equ
+    // relative to a label is a label itself
+    Symbol &symbol = symbols_[symbolIdx];
+    symbol.equ = EQU_NONE;
+    if (res == AE_OK && !value.abs() && symbols_[value.symbol].external) {
+        message = ".equ relative to an external symbol: " + std::string(atoms_.name(symbol.name));
+        res = AE_SYNTAX_NOSKIP;
+    }
 
-    // Relocation entry for labels, external symbols or PC relative addressing
-    RelEntry relEntry(pcRel_ ? RT_PC : (instr ? RT_SYM_16_BE : RT_SYM_16), section_->data.size(), 0);
-    bool rel = pcRel_;
-
-    if (literal)
-        value = *literal;
-    else {
-        const std::string &symbolName = std::get<std::string>(arg);
-        Symbol &symbol = getSymbol(symbolName);
-        if (!symbol.defined() && !symbol.external) {
-            error("undeclared symbol " + symbolName);
-            return AE_SYNTAX_NOSKIP;
+    if (res != AE_OK) {
+        if (!message.empty()) // report at the definition
+            errorAt(equs_[index].file, equs_[index].line, equs_[index].column, message);
+        return res;
+    }
+
+    symbol.entry.value = value.value;
+    if (!value.abs()) {
+        symbol.entry.type = SYMT_LABEL;
+        symbol.section = symbols_[value.symbol].section;
+    }
+
+    return AE_OK;
+}
+
+void Assembler::resolveEqus()
+{
+    for (uint i = 0; i < equs_.size(); ++i)
+        if (symbols_[equs_[i].symbol].equ != EQU_NONE)
+            resolveEqu(i);
+}
+
+int Assembler::dirArg(operand_variant arg)
+{
+    dirArgs_.push_back(arg);
+    return AE_OK;
+}
+int Assembler::dirArgString(std::string_view str)
+{
+    if (!dirArgs_.empty() || dirString_.data()) {
+        syntaxError("unexpected string: \"" + std::string(str) + "\"");
+        return AE_SYNTAX_NOSKIP;
+    }
+    dirString_ = str;
+    return AE_OK;
+}
+
+int Assembler::label(Atom label)
+{
+    if (section_ == SECTION_NONE) {
+        error("label not in any section: " + std::string(atoms_.name(label)));
+        return AE_SYNTAX_NOSKIP;
+    }
+    Symbol &symbol = getSymbol(label);
+    if (symbol.defined()) {
+        error("symbol already defined: " + std::string(atoms_.name(label)));
+        return AE_SYNTAX_NOSKIP;
+    } else { // symbol definition
+        symbol.external = false;
+        symbol.section = section_;
+        symbol.entry.type = SYMT_LABEL;
+        symbol.entry.value = (ushort)lc_;
+        labeled_ = true;
+    }
+
+    return AE_OK;
+}
+
+int Assembler::processWord(const IrWord &word, bool instr, SectionEncoder &encoder)
+{
+    ushort value = word.value; // literal
+
+    if (!word.literal()) {
+        if (options_.singlePass) // patched at .end
+            fixups_.push_back({ word, section_, (ushort)encoder.size, instr, encoder.pcRel });
+        else {
+            int res = resolveSymbolWord(word, encoder.size, instr, value, encoder);
+            if (res != AE_OK)
+                return res;
         }
+    }
+
+    ubyte *data = encoder.emit(2);
+    if (instr) {
+        data[0] = value >> 8; // DataHigh
+        data[1] = value; // DataLow
+    } else {
+        data[0] = value; // DataLow
+        data[1] = value >> 8; // DataHigh
+    }
 
-        value = symbol.entry.value;
+    return AE_OK;
+}
 
-        if (symbol.label()) {
-            relEntry.symbolId = getSectionSymbol(symbol.section).id;
-            rel = true;
-        } else if (symbol.external) {
-            relEntry.symbolId = symbol.id;
-            rel = true;
+int Assembler::resolveSymbolWord(const IrWord &word, ushort offset, bool instr, ushort &value, SectionEncoder &encoder)
+{
+    ExprValue result{ 0, word.symbol };
+    if (word.expr != EXPR_NONE) {
+        std::string message;
+        if (evalExpr(word.expr, result, message) != AE_OK) {
+            encoder.errors.push_back({ &word, message });
+            return AE_SYNTAX_NOSKIP;
+        }
+        if (result.abs()) { // folded (expressions are never PC relative)
+            value = result.value;
+            return AE_OK;
         }
     }
 
+    // A lone symbol or the symbol an expression is relative to
+    const Symbol &symbol = symbols_[result.symbol];
+    if (!symbol.defined() && !symbol.external) {
+        encoder.errors.push_back({ &word, "undeclared symbol " + std::string(atoms_.name(symbol.name)) });
+        return AE_SYNTAX_NOSKIP;
+    }
+    if (word.expr == EXPR_NONE)
+        result.value = symbol.entry.value;
+
+    // Label in the same section as a PC relative operand: the operand ends
+    // the instruction, so the displacement to the next one is known already
+    if (encoder.pcRel && symbol.label() && &sections_[symbol.section] == encoder.section) {
+        value = result.value - (offset + 2);
+        ++encoder.resolvedPcRelocations;
+        return AE_OK;
+    }
+
+    // Relocation entry for labels, external symbols or PC relative addressing
+    RelEntry relEntry(encoder.pcRel ? RT_PC : (instr ? RT_SYM_16_BE : RT_SYM_16), offset, 0);
+    bool rel = encoder.pcRel;
+
+    value = result.value;
+
+    std::pmr::vector<ubyte> &relData = encoder.relSection->data;
+    if (symbol.label()) {
+        // section symbol id is filled in by stitchSection
+        encoder.sectionRefs.push_back({ relData.size(), symbol.section });
+        rel = true;
+    } else if (symbol.external) {
+        relEntry.symbolId = symbol.id;
+        rel = true;
+    }
+
     if (rel) {
+        ++encoder.relocations[relEntry.type];
         auto const relBegin = (const ubyte*)&relEntry;
         auto const relEnd = relBegin + sizeof(RelEntry);
-        relSection_->data.insert(relSection_->data.end(), relBegin, relEnd);
-    }
-
-    if (instr) {
-        section_->data.push_back(value >> 8); // DataHigh
-        section_->data.push_back(value); // DataLow
-    } else {
-        section_->data.push_back(value); // DataLow
-        section_->data.push_back(value >> 8); // DataHigh
+        relData.insert(relData.end(), relBegin, relEnd);
     }
 
     return AE_OK;
 }
 
-Symbol& Assembler::getSymbol(const std::string &symbolName)
+int Assembler::patchFixups()
 {
-    auto sit = symbols_.find(symbolName);
-    if (sit != symbols_.end())
-        return sit->second;
+    int res = AE_OK;
+    uint section = SECTION_NONE;
+    SectionEncoder encoder;
+
+    for (const Fixup &fixup : fixups_) {
+        if (fixup.section != section) {
+            if (stitchSection(encoder) != AE_OK)
+                res = AE_SYNTAX_NOSKIP;
+
+            section = fixup.section;
+            encoder = SectionEncoder();
+            encoder.section = &sections_[section];
+            encoder.relSection = &sections_[encoder.section->rel];
+        }
 
-    // new symbol
-    Symbol &symbol = symbols_[symbolName];
+        encoder.pcRel = fixup.pcRel;
 
-    return symbol;
+        ushort value;
+        if (resolveSymbolWord(fixup.word, fixup.offset, fixup.instr, value, encoder) != AE_OK)
+            continue;
+
+        ubyte *word = &encoder.section->data[fixup.offset];
+        if (fixup.instr) {
+            word[0] = value >> 8; // DataHigh
+            word[1] = value; // DataLow
+        } else {
+            word[0] = value; // DataLow
+            word[1] = value >> 8; // DataHigh
+        }
+    }
+
+    if (stitchSection(encoder) != AE_OK)
+        res = AE_SYNTAX_NOSKIP;
+
+    return res;
+}
+
+uint Assembler::symbolIndex(Atom symbolName)
+{
+    // Atoms are dense, so the index is a direct lookup
+    if (symbolName >= symbolIndex_.size())
+        symbolIndex_.resize(atoms_.size(), SYMBOL_NONE);
+
+    uint &index = symbolIndex_[symbolName];
+    if (index == SYMBOL_NONE) { // new symbol
+        index = symbols_.size();
+        symbols_.emplace_back().name = symbolName;
+    }
+
+    return index;
 }
 
-const Symbol& Assembler::getSectionSymbol(const std::string &sectionName)
+const Symbol& Assembler::getSectionSymbol(uint sectionIndex)
 {
-    Symbol &sectionSymbol = getSymbol(sectionName);
+    const Section &section = sections_[sectionIndex];
+    Symbol &sectionSymbol = getSymbol(section.name);
     if (sectionSymbol.entry.type == SYMT_UNDEF) {
         // Add section symbol to the symbol table so it has an id
         // for relocation entries
-        const Section &section = sections_[sectionName];
-        sectionSymbol.section = sectionName;
+        ++stats_.sectionSymbols;
+        sectionSymbol.section = sectionIndex;
         sectionSymbol.entry.bind = SYMB_LOCAL;
         sectionSymbol.entry.type = SYMT_SECTION;
         sectionSymbol.entry.nameOffset = section.entry.nameOffset;
@@ -702,26 +1880,19 @@ const Symbol& Assembler::getSectionSymbol(const std::string &sectionName)
 
 void Assembler::writeObjHeader()
 {
-    outFile_.seekp(0);
-
-    outFile_.write(
-        (const char*)&objHeader_,
-        sizeof(ObjHeader)
-    );
+    std::memcpy(out_.data(), &objHeader_, sizeof(ObjHeader));
 }
 
 void Assembler::initSymbolTable()
 {
-    // Insert symbol table section so access to it doesn't cause reallocation
-    // of section map and invalidate section pointers
-    sections_[SYM_TAB_SECTION] = Section(ST_SYM_TAB);
+    sections_.emplace_back(ST_SYM_TAB, intern(SYM_TAB_SECTION)); // SYM_TAB_INDEX
     Symbol invalidSymbol;
     insertSymbolTableEntry(invalidSymbol);
 }
 
 void Assembler::insertSymbolTableEntry(Symbol &symbol)
 {
-    Section &symTabSection = sections_[SYM_TAB_SECTION];
+    Section &symTabSection = sections_[SYM_TAB_INDEX];
 
     symbol.id = symTabSection.data.size() / sizeof(SymbolEntry);
 
@@ -732,13 +1903,12 @@ void Assembler::insertSymbolTableEntry(Symbol &symbol)
 
 void Assembler::fillSymbolTable()
 {
-    Section &symTabSection = sections_[SYM_TAB_SECTION];
-    symTabSection.data.reserve(symbols_.size());
-
-    for (auto& [symbolName, symbol] : symbols_) {
-        if (symbol.entry.type == SYMT_SECTION)
-            continue;
+    Section &symTabSection = sections_[SYM_TAB_INDEX];
+    // room for every symbol and the section symbols added on first relocation
+    symTabSection.data.reserve(symTabSection.data.size()
+                               + (symbols_.size() + sectionOrder_.size()) * sizeof(SymbolEntry));
 
+    for (Symbol &symbol : symbols_) {
         switch (symbol.entry.type) {
         case SYMT_UNDEF: // extern symbol
             if (symbol.external) {
@@ -751,6 +1921,8 @@ void Assembler::fillSymbolTable()
             break;
         case SYMT_ABS:
         case SYMT_LABEL:
+            if (symbol.label())
+                symbol.entry.sectionEntryId = sections_[symbol.section].id;
             if (symbol.global)
                 symbol.entry.bind = SYMB_GLOBAL;
             else
@@ -760,48 +1932,36 @@ void Assembler::fillSymbolTable()
             continue;
         }
 
-        symbol.entry.nameOffset = insertStrSectionEntry(symbolName);
+        symbol.entry.nameOffset = insertStrSectionEntry(atoms_.name(symbol.name));
         insertSymbolTableEntry(symbol);
     }
 }
 
 void Assembler::endSymbolTable()
 {
-    Section &symTabSection = sections_[SYM_TAB_SECTION];
-    SymbolEntry* symTab = (SymbolEntry*)symTabSection.data.cbegin().base();
+    Section &symTabSection = sections_[SYM_TAB_INDEX];
 
-    for (auto& [symbolName, symbol] : symbols_) {
-        if (symbol.entry.type == SYMT_SECTION)
+    for (const Symbol &symbol : symbols_) {
+        if (symbol.entry.type == SYMT_SECTION || symbol.id == 0) // inserted on first rel entry or ignored
             continue;
 
-        if (symbol.id == 0) // ignored symbols
-            continue;
-
-        symTab[symbol.id] = symbol.entry;
+        // byte storage, not necessarily aligned for SymbolEntry
+        std::memcpy(&symTabSection.data[symbol.id * sizeof(SymbolEntry)], &symbol.entry, sizeof(SymbolEntry));
     }
 
-    insertSectionTableEntry(SYM_TAB_SECTION, symTabSection);
-    writeSection(symTabSection);
-}
-
-void Assembler::initRelSection()
-{
-    // Insert relocation section so access to it doesn't cause reallocation
-    // of section map and invalidate section pointers
-    sections_[relSectionName_] = Section(ST_REL);
+    insertSectionTableEntry(symTabSection);
+    placeSection(SYM_TAB_INDEX);
 }
 
 void Assembler::initStrSection()
 {
-    // Insert names section so access to it doesn't cause reallocation
-    // of section map and invalidate section pointers
-    Section &strSection = sections_[STR_SECTION] = Section(ST_STR);
+    Section &strSection = sections_.emplace_back(ST_STR, intern(STR_SECTION)); // STR_INDEX
     strSection.data.push_back('\0');
 }
 
-std::size_t Assembler::insertStrSectionEntry(const std::string &str)
+std::size_t Assembler::insertStrSectionEntry(std::string_view str)
 {
-    Section &strSection = sections_[STR_SECTION];
+    Section &strSection = sections_[STR_INDEX];
     std::size_t pos = strSection.data.size();
 
     strSection.data.insert(strSection.data.end(), str.cbegin(), str.cend());
@@ -812,9 +1972,9 @@ std::size_t Assembler::insertStrSectionEntry(const std::string &str)
 
 void Assembler::endStrSection()
 {
-    Section &strSection = sections_[STR_SECTION];
-    insertSectionTableEntry(STR_SECTION, strSection);
-    writeSection(strSection);
+    Section &strSection = sections_[STR_INDEX];
+    insertSectionTableEntry(strSection);
+    placeSection(STR_INDEX);
     objHeader_.strEntryId = strSection.id;
 }
 
@@ -826,69 +1986,183 @@ void Assembler::initSectionHeaderTable()
 
 void Assembler::endSectionHeaderTable()
 {
-    objHeader_.shtOffset = outFile_.tellp();
+    objHeader_.shtOffset = outSize_;
     objHeader_.shtSize = sectionHeaderTable_.size();
-
-    outFile_.write(
-        (const char*)sectionHeaderTable_.data(),
-        sectionHeaderTable_.size() * sizeof(SectionEntry)
-    );
+    outSize_ += sectionHeaderTable_.size() * sizeof(SectionEntry);
 }
 
 void Assembler::endSection()
 {
-    if (sectionName_.empty())
+    if (section_ == SECTION_NONE)
         return;
 
-    if (lc_ == 0 && section_->entry.size == 0)
+    Section &section = sections_[section_];
+    if (lc_ == 0 && section.entry.size == 0)
         return;
 
-    if (pass_ == 0) {
-        insertSectionTableEntry(sectionName_, *section_, lc_);
-        section_->data.reserve(lc_);
-        lc_ = 0;
-    } else {
-        writeSection(*section_);
-        if (!relSection_->data.empty()) {
-            insertSectionTableEntry(relSectionName_, *relSection_);
-            writeSection(*relSection_);
-        }
+    // Trailing .skip bytes are not stored
+    if (options_.zeroFill && dataEnd_ < lc_) {
+        section.entry.flags |= SF_ZERO_FILL;
+        section.entry.fileSize = dataEnd_;
     }
 
-    sectionDataCache_ = std::move(section_->data);
-    relSectionDataCache_ = std::move(relSection_->data);
-    sectionDataCache_.clear();
-    relSectionDataCache_.clear();
+    // Data is encoded in place (second pass) or kept until symbol
+    // references are patched (single pass)
+    insertSectionTableEntry(section, lc_);
+    lc_ = 0;
+    dataEnd_ = 0;
 }
 
-void Assembler::insertSectionTableEntry(const std::string &sectionName, Section &section, ushort size)
+void Assembler::insertSectionTableEntry(Section &section, std::size_t size)
 {
+    std::string_view sectionName = atoms_.name(section.name);
     section.id = sectionHeaderTable_.size();
-    section.entry.nameOffset = insertStrSectionEntry(sectionName);
-    section.entry.size = size ? size : section.data.size();
+    section.entry.nameOffset = insertStrSectionEntry(sectionName); // may grow the names section itself
+
+    if (!size)
+        size = section.data.size();
+    if (size > 0xFFFFu) // section sizes and offsets are 16 bit
+        error("section too large (" + std::to_string(size) + " bytes): " + std::string(sectionName));
+    section.entry.size = size;
     sectionHeaderTable_.push_back(section.entry);
 }
 
-void Assembler::writeSection(Section &section)
+void Assembler::placeSection(uint index)
 {
-    sectionHeaderTable_[section.id].dataOffset = section.entry.dataOffset = outFile_.tellp();
-    outFile_.write(
-        (const char *)section.data.data(),
-        section.entry.size
-    );
+    Section &section = sections_[index];
+    sectionHeaderTable_[section.id].dataOffset = section.entry.dataOffset = outSize_;
+    outSize_ += section.entry.storedSize();
+    layout_.push_back(index);
+}
+
+void Assembler::layoutDataSections()
+{
+    // Data sections come right after the header
+    for (uint index : sectionOrder_) {
+        if (sections_[index].entry.size != 0)
+            placeSection(index);
+    }
+}
+
+// Unsigned LEB128
+static ubyte* putVarint(ubyte *out, uint value)
+{
+    while (value >= 0x80u) {
+        *out++ = (ubyte)(value | 0x80u);
+        value >>= 7;
+    }
+    *out++ = (ubyte)value;
+    return out;
+}
+
+void Assembler::packRelSection(Section &relSection)
+{
+    std::vector<RelEntry> entries(relSection.data.size() / sizeof(RelEntry), RelEntry(RT_SYM_16, 0, 0));
+    std::memcpy(entries.data(), relSection.data.data(), entries.size() * sizeof(RelEntry));
+    std::sort(entries.begin(), entries.end(), [](const RelEntry &a, const RelEntry &b) {
+        return a.offset < b.offset;
+    });
+
+    // Entries never grow, the packed form overwrites the raw one
+    ubyte *out = relSection.data.data();
+    ushort offset = 0;
+    int symbolId = 0;
+    for (const RelEntry &rel : entries) {
+        int delta = rel.symbolId - symbolId;
+        out = putVarint(out, (uint)(rel.offset - offset) << 2 | rel.type);
+        out = putVarint(out, (uint)delta << 1 ^ (uint)(delta >> 31)); // zigzag
+        offset = rel.offset;
+        symbolId = rel.symbolId;
+    }
+
+    relSection.data.resize(out - relSection.data.data());
+    relSection.entry.flags |= SF_PACKED_REL;
+}
+
+void Assembler::writeSection(const Section &section)
+{
+    // Sections encoded in place have no data of their own, and single
+    // pass data ends at the last instruction or .word (the rest is zero)
+    if (!section.data.empty())
+        std::memcpy(out_.data() + section.entry.dataOffset, section.data.data(), section.data.size());
+}
+
+void Assembler::endObjFile()
+{
+    beginPhase(PHASE_WRITE);
+
+    // Layout: header, data sections, relocation sections, symbol table,
+    // names, section header table
+    for (uint index : sectionOrder_) {
+        const Section &section = sections_[index];
+        if (section.entry.size == 0)
+            continue;
+
+        Section &relSection = sections_[section.rel];
+        if (!relSection.data.empty()) {
+            if (options_.packedRelocations)
+                packRelSection(relSection);
+            insertSectionTableEntry(relSection);
+            placeSection(section.rel);
+        }
+    }
+    endSymbolTable();
+    endStrSection();
+    endSectionHeaderTable();
+
+    if (error_)
+        return;
+
+    // Everything is known now, write the file in one go
+    out_.resize(outSize_);
+    for (uint index : layout_)
+        writeSection(sections_[index]);
+    std::memcpy(out_.data() + objHeader_.shtOffset, sectionHeaderTable_.data(),
+                sectionHeaderTable_.size() * sizeof(SectionEntry));
+    writeObjHeader();
 }
 
 void Assembler::syntaxError(const std::string& msg)
 {
     error_ = true;
-    parser_.error(getLocation(), "syntax error, " + msg);
+    report(DIAG_SYNTAX_ERROR, getLocation(), msg);
 }
 void Assembler::error(const std::string& msg)
 {
     error_ = true;
-    parser_.error(getLocation(), "error, " + msg);
+    report(DIAG_ERROR, getLocation(), msg);
 }
 void Assembler::warning(const std::string& msg)
 {
-    parser_.error(getLocation(), "warning, " + msg);
-}
\ No newline at end of file
+    report(DIAG_WARNING, getLocation(), msg);
+}
+
+void Assembler::report(DiagnosticKind kind, const yy::location& loc, const std::string& msg)
+{
+    Diagnostic diagnostic{kind, (uint)loc.begin.line, (uint)loc.begin.column, msg};
+
+    // Lines in a .rept or macro body are followed by where it was expanded
+    // (the innermost expansions and the use in the source)
+    const std::size_t SHOWN_EXPANSIONS = 3;
+    for (auto it = expansions_.rbegin(); it != expansions_.rend(); ++it) {
+        std::size_t depth = it - expansions_.rbegin();
+        if (depth >= SHOWN_EXPANSIONS && it + 1 != expansions_.rend()) {
+            if (depth == SHOWN_EXPANSIONS)
+                diagnostic.message += ", ...";
+            continue;
+        }
+        diagnostic.message += depth == 0 ? " (in " : ", ";
+        if (it->dir == MACRO)
+            diagnostic.message += "macro " + std::string(atoms_.name(macros_[it->macro].name));
+        else
+            diagnostic.message += it->dir == REPT ? ".rept" : ".include";
+        diagnostic.message += " at line " + std::to_string(it->line);
+    }
+    if (!expansions_.empty())
+        diagnostic.message += ")";
+    if (records_)
+        records_->push_back(std::move(diagnostic));
+    else
+        *diagnostics_ << *loc.begin.filename << ":" << loc.begin.line << ":" << loc.begin.column
+                      << ": " << diagnostic.text() << std::endl;
+}
@@ -0,0 +1,59 @@
+#include "atom.hpp"
+
+#include <cstring>
+
+const std::size_t ATOM_BLOCK_SIZE = 64 * 1024;
+
+AtomTable::AtomTable() :
+    blockPos_(nullptr), blockLeft_(0)
+{
+    clear();
+}
+
+Atom AtomTable::intern(std::string_view str)
+{
+    auto it = atoms_.find(str);
+    if (it != atoms_.end())
+        return it->second;
+
+    // new atom
+    std::string_view name(store(str), str.size());
+    Atom atom = (Atom)names_.size();
+    names_.push_back(name);
+    atoms_.emplace(name, atom);
+
+    return atom;
+}
+
+void AtomTable::clear()
+{
+    atoms_.clear();
+    names_.clear();
+
+    if (blocks_.size() > 1)
+        blocks_.resize(1);
+    if (!blocks_.empty()) {
+        blockPos_ = blocks_[0].get();
+        blockLeft_ = ATOM_BLOCK_SIZE;
+    }
+
+    names_.emplace_back(); // ATOM_NONE
+    atoms_.emplace(names_[ATOM_NONE], ATOM_NONE);
+}
+
+const char* AtomTable::store(std::string_view str)
+{
+    if (str.size() > blockLeft_) {
+        std::size_t blockSize = str.size() > ATOM_BLOCK_SIZE ? str.size() : ATOM_BLOCK_SIZE;
+        blocks_.emplace_back(new char[blockSize]);
+        blockPos_ = blocks_.back().get();
+        blockLeft_ = blockSize;
+    }
+
+    char *pos = blockPos_;
+    std::memcpy(pos, str.data(), str.size());
+    blockPos_ += str.size();
+    blockLeft_ -= str.size();
+
+    return pos;
+}
@@ -0,0 +1,69 @@
+#include "batch.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+namespace
+{
+
+struct BatchResult
+{
+    std::string diagnostics;
+    int res = AE_OK;
+    bool done = false;
+};
+
+}
+
+int runBatch(const std::vector<BatchJob>& jobs, const AssemblerOptions& options,
+             unsigned workers, std::ostream& out)
+{
+    std::vector<BatchResult> results(jobs.size());
+    std::atomic<std::size_t> next(0);
+    std::mutex mutex;
+    std::condition_variable doneCond;
+
+    auto worker = [&]() {
+        Assembler assembler(options);
+        std::ostringstream diagnostics;
+        assembler.setDiagnostics(diagnostics);
+
+        std::size_t i;
+        while ((i = next.fetch_add(1, std::memory_order_relaxed)) < jobs.size()) {
+            diagnostics.str(std::string());
+            int res = assembler.run(jobs[i].inFilename, jobs[i].outFilename);
+
+            std::lock_guard<std::mutex> lock(mutex);
+            results[i].diagnostics = diagnostics.str();
+            results[i].res = res;
+            results[i].done = true;
+            doneCond.notify_one();
+        }
+    };
+
+    workers = std::max(1u, std::min<unsigned>(workers, jobs.size()));
+    std::vector<std::thread> threads;
+    threads.reserve(workers);
+    for (unsigned w = 0; w < workers; ++w)
+        threads.emplace_back(worker);
+
+    // Print each job as soon as it and all jobs before it are done
+    int res = AE_OK;
+    for (BatchResult& result : results) {
+        std::unique_lock<std::mutex> lock(mutex);
+        doneCond.wait(lock, [&result] { return result.done; });
+        lock.unlock();
+
+        out << result.diagnostics << std::flush;
+        res = std::max(res, result.res);
+    }
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    return res;
+}
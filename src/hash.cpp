@@ -0,0 +1,93 @@
+#include "hash.hpp"
+
+#include <cstring>
+
+static inline std::uint64_t rotl64(std::uint64_t x, int r)
+{
+    return (x << r) | (x >> (64 - r));
+}
+
+static inline std::uint64_t fmix64(std::uint64_t k)
+{
+    k ^= k >> 33;
+    k *= 0xff51afd7ed558ccdull;
+    k ^= k >> 33;
+    k *= 0xc4ceb9fe1a85ec53ull;
+    k ^= k >> 33;
+    return k;
+}
+
+Hash128 hash128(const void *data, std::size_t size, std::uint64_t seed)
+{
+    const std::uint64_t c1 = 0x87c37b91114253d5ull;
+    const std::uint64_t c2 = 0x4cf5ad432745937full;
+
+    const unsigned char *bytes = (const unsigned char*)data;
+    const std::size_t blocks = size / 16;
+
+    std::uint64_t h1 = seed;
+    std::uint64_t h2 = seed;
+
+    for (std::size_t i = 0; i < blocks; ++i) {
+        std::uint64_t k1, k2;
+        std::memcpy(&k1, bytes + i * 16, 8);
+        std::memcpy(&k2, bytes + i * 16 + 8, 8);
+
+        k1 *= c1; k1 = rotl64(k1, 31); k1 *= c2; h1 ^= k1;
+        h1 = rotl64(h1, 27); h1 += h2; h1 = h1 * 5 + 0x52dce729;
+
+        k2 *= c2; k2 = rotl64(k2, 33); k2 *= c1; h2 ^= k2;
+        h2 = rotl64(h2, 31); h2 += h1; h2 = h2 * 5 + 0x38495ab5;
+    }
+
+    // tail
+    const unsigned char *tail = bytes + blocks * 16;
+    std::uint64_t k1 = 0, k2 = 0;
+
+    switch (size & 15) {
+    case 15: k2 ^= (std::uint64_t)tail[14] << 48; [[fallthrough]];
+    case 14: k2 ^= (std::uint64_t)tail[13] << 40; [[fallthrough]];
+    case 13: k2 ^= (std::uint64_t)tail[12] << 32; [[fallthrough]];
+    case 12: k2 ^= (std::uint64_t)tail[11] << 24; [[fallthrough]];
+    case 11: k2 ^= (std::uint64_t)tail[10] << 16; [[fallthrough]];
+    case 10: k2 ^= (std::uint64_t)tail[9] << 8; [[fallthrough]];
+    case 9:  k2 ^= (std::uint64_t)tail[8];
+             k2 *= c2; k2 = rotl64(k2, 33); k2 *= c1; h2 ^= k2;
+             [[fallthrough]];
+    case 8:  k1 ^= (std::uint64_t)tail[7] << 56; [[fallthrough]];
+    case 7:  k1 ^= (std::uint64_t)tail[6] << 48; [[fallthrough]];
+    case 6:  k1 ^= (std::uint64_t)tail[5] << 40; [[fallthrough]];
+    case 5:  k1 ^= (std::uint64_t)tail[4] << 32; [[fallthrough]];
+    case 4:  k1 ^= (std::uint64_t)tail[3] << 24; [[fallthrough]];
+    case 3:  k1 ^= (std::uint64_t)tail[2] << 16; [[fallthrough]];
+    case 2:  k1 ^= (std::uint64_t)tail[1] << 8; [[fallthrough]];
+    case 1:  k1 ^= (std::uint64_t)tail[0];
+             k1 *= c1; k1 = rotl64(k1, 31); k1 *= c2; h1 ^= k1;
+    }
+
+    // finalization
+    h1 ^= size;
+    h2 ^= size;
+
+    h1 += h2;
+    h2 += h1;
+
+    h1 = fmix64(h1);
+    h2 = fmix64(h2);
+
+    h1 += h2;
+    h2 += h1;
+
+    return Hash128{ h1, h2 };
+}
+
+std::string Hash128::hex() const
+{
+    static const char DIGITS[] = "0123456789abcdef";
+    std::string str(32, '0');
+    for (int i = 0; i < 16; ++i) {
+        str[15 - i] = DIGITS[(high >> (i * 4)) & 0xF];
+        str[31 - i] = DIGITS[(low >> (i * 4)) & 0xF];
+    }
+    return str;
+}
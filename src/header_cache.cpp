@@ -0,0 +1,34 @@
+#include "header_cache.hpp"
+
+#include <sys/stat.h>
+
+HeaderCache& HeaderCache::shared()
+{
+    static HeaderCache cache;
+    return cache;
+}
+
+bool HeaderCache::stamp(const std::string& path, FileStamp &stamp)
+{
+    struct stat st;
+    if (::stat(path.c_str(), &st) != 0 || !S_ISREG(st.st_mode))
+        return false;
+    stamp.mtime = (std::int64_t)st.st_mtim.tv_sec * 1000000000 + st.st_mtim.tv_nsec;
+    stamp.size = st.st_size;
+    return true;
+}
+
+std::shared_ptr<const HeaderBlob> HeaderCache::find(const std::string& path, const FileStamp& stamp)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(path);
+    if (it == entries_.end() || !(it->second.stamp == stamp))
+        return nullptr;
+    return it->second.blob;
+}
+
+void HeaderCache::insert(const std::string& path, const FileStamp& stamp, std::shared_ptr<const HeaderBlob> blob)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_[path] = Entry{ stamp, std::move(blob) };
+}
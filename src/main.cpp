@@ -1,37 +1,179 @@
+#include <cstdlib>
 #include <iostream>
 #include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include <sys/stat.h>
 
 #include "assembler.hpp"
+#include "batch.hpp"
+#include "server.hpp"
+#include "alloc_stats.hpp"
+
+static const char *const USAGE =
+    "usage: assembler [options] -o <output> <input>\n"
+    "       assembler [options] -d <dir> <input>...      outputs <dir>/<input name>.o\n"
+    "       assembler [options] <input>:<output>...\n"
+    "An argument naming an existing file is an input as a whole, otherwise\n"
+    "<input>:<output> is split at its last ':'. \"-\" reads standard input\n"
+    "(with --client).\n";
+
+// <input>:<output> split at the last ':', unless the whole argument names a
+// file (inputs may contain ':'). False for a plain input.
+static bool splitJob(const std::string& input, BatchJob &job)
+{
+    struct stat st;
+    std::size_t sep = input.rfind(':');
+    if (sep == std::string::npos || sep == 0 || sep + 1 == input.size() || stat(input.c_str(), &st) == 0)
+        return false;
+    job.inFilename = input.substr(0, sep);
+    job.outFilename = input.substr(sep + 1);
+    return true;
+}
+
+// <dir>/<input file name without extension>.o
+static std::string outputInDir(const std::string& outDir, const std::string& inFilename)
+{
+    std::string name = inFilename.substr(inFilename.find_last_of('/') + 1);
+    std::size_t ext = name.find_last_of('.');
+    if (ext != std::string::npos && ext != 0)
+        name.erase(ext);
+    return outDir + "/" + name + ".o";
+}
 
 int main(int argc, char *argv[])
 {
-    std::string inFilename, outFilename;
+    std::vector<std::string> inputs;
+    std::string outFilename, outDir;
+    AssemblerOptions options;
+    unsigned workers = std::thread::hardware_concurrency();
+    bool allocStats = false;
+    std::string serverSocket, clientSocket, stopSocket;
 
     for (int i = 1; i < argc; ++i) {
         if (argv[i] == std::string("-o")) {
-            if (i < argc) {
+            if (i + 1 < argc) {
                 ++i;
                 outFilename = argv[i];
             }
-        } else
-            inFilename = argv[i];
+        } else if (argv[i] == std::string("-d")) {
+            if (i + 1 < argc) {
+                ++i;
+                outDir = argv[i];
+            }
+        } else if (argv[i] == std::string("-j")) {
+            if (i + 1 < argc) {
+                ++i;
+                workers = std::strtoul(argv[i], nullptr, 10);
+            }
+        } else if (argv[i] == std::string("--cache-dir")) {
+            if (i + 1 < argc) {
+                ++i;
+                options.cacheDir = argv[i];
+            }
+        } else if (argv[i] == std::string("--server")) {
+            if (i + 1 < argc) {
+                ++i;
+                serverSocket = argv[i];
+            }
+        } else if (argv[i] == std::string("--client")) {
+            if (i + 1 < argc) {
+                ++i;
+                clientSocket = argv[i];
+            }
+        } else if (argv[i] == std::string("--stop-server")) {
+            if (i + 1 < argc) {
+                ++i;
+                stopSocket = argv[i];
+            }
+        } else if (argv[i] == std::string("--single-pass"))
+            options.singlePass = true;
+        else if (argv[i] == std::string("--packed-rel"))
+            options.packedRelocations = true;
+        else if (argv[i] == std::string("--zero-fill"))
+            options.zeroFill = true;
+        else if (argv[i] == std::string("-O"))
+            options.optimize = true;
+        else if (argv[i] == std::string("--stats"))
+            options.stats = STATS_TEXT;
+        else if (argv[i] == std::string("--stats-json"))
+            options.stats = STATS_JSON;
+        else if (argv[i] == std::string("--alloc-stats"))
+            allocStats = true;
+        else
+            inputs.push_back(argv[i]);
     }
 
     int res = AE_OK;
+    std::size_t allocations = heapAllocationCount();
+
+    if (!serverSocket.empty())
+        return runServer(serverSocket, options, workers, std::cout);
+    if (!stopSocket.empty())
+        return stopServer(stopSocket, std::cout);
 
-    if (inFilename.empty()) {
-        std::cout << "No input file provided\n";
-        res = AE_FILE;
+    if (inputs.empty()) {
+        std::cout << "No input file provided\n" << USAGE;
+        return AE_FILE;
     }
-    if (outFilename.empty()) {
-        std::cout << "No output file provided\n";
-        res = AE_FILE;
+
+    BatchJob single;
+    if (inputs.size() == 1 && outDir.empty() && !splitJob(inputs[0], single)) {
+        if (outFilename.empty()) {
+            std::cout << "No output file provided\n";
+            return AE_FILE;
+        }
+
+        if (!clientSocket.empty())
+            return runClient(clientSocket, { BatchJob{inputs[0], outFilename} }, options, std::cout);
+
+        options.sectionJobs = workers; // one file, encode its sections in parallel
+        Assembler assembler(options);
+        res = assembler.run(inputs[0], outFilename);
+        if (allocStats)
+            std::cout << "heap allocations: " << heapAllocationCount() - allocations
+                      << " (" << assembler.lines() << " lines)" << std::endl;
+        return res;
     }
 
-    if (res == AE_OK) {
-        Assembler assembler;
-        res = assembler.run(inFilename, outFilename);
+    // Batch mode: <input> (output in -d directory) or <input>:<output>
+    if (!outFilename.empty()) {
+        std::cout << "-o takes a single input, use -d <dir> or <input>:<output>\n";
+        return AE_FILE;
     }
 
+    std::vector<BatchJob> jobs;
+    std::unordered_set<std::string> outFilenames;
+    for (const std::string& input : inputs) {
+        BatchJob job;
+        if (!splitJob(input, job)) {
+            if (outDir.empty()) {
+                std::cout << "No output file provided for: " << input << "\n";
+                res = AE_FILE;
+                continue;
+            }
+            job.inFilename = input;
+            job.outFilename = outputInDir(outDir, input);
+        }
+
+        if (!outFilenames.insert(job.outFilename).second) {
+            std::cout << "Output file used more than once: " << job.outFilename << "\n";
+            res = AE_FILE;
+        }
+        jobs.push_back(job);
+    }
+    if (res != AE_OK)
+        return res;
+
+    if (!clientSocket.empty())
+        return runClient(clientSocket, jobs, options, std::cout);
+
+    res = runBatch(jobs, options, workers, std::cout);
+    if (allocStats)
+        std::cout << "heap allocations: " << heapAllocationCount() - allocations
+                  << " (" << jobs.size() << " files)" << std::endl;
+
     return res;
 }
@@ -0,0 +1,57 @@
+#include "mapped_file.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::MappedFile() :
+    data_(nullptr), size_(0), open_(false)
+{}
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+bool MappedFile::open(const std::string& filename)
+{
+    close();
+
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        ::close(fd);
+        return false;
+    }
+
+    if (st.st_size > 0) {
+        void *addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr == MAP_FAILED) {
+            ::close(fd);
+            return false;
+        }
+        madvise(addr, st.st_size, MADV_SEQUENTIAL);
+        data_ = (const char*)addr;
+        size_ = st.st_size;
+    }
+
+    // mapping stays valid after the descriptor is closed
+    ::close(fd);
+    open_ = true;
+
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (data_)
+        munmap((void*)data_, size_);
+
+    data_ = nullptr;
+    size_ = 0;
+    open_ = false;
+}
@@ -0,0 +1,100 @@
+#include "object_cache.hpp"
+
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <linux/fs.h>
+#endif
+
+#include "version.hpp"
+
+// Copy a regular file, sharing extents (reflink) when the filesystem can
+static bool copyFile(const std::string& from, const std::string& to)
+{
+    int in = ::open(from.c_str(), O_RDONLY);
+    if (in < 0)
+        return false;
+    int out = ::open(to.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666);
+    if (out < 0) {
+        ::close(in);
+        return false;
+    }
+
+    bool ok = false;
+#ifdef FICLONE
+    ok = ::ioctl(out, FICLONE, in) == 0;
+#endif
+
+    if (!ok) {
+        char buf[64 * 1024];
+        ssize_t n;
+        ok = true;
+        while (ok && (n = ::read(in, buf, sizeof(buf))) != 0) {
+            if (n < 0) {
+                ok = errno == EINTR;
+                continue;
+            }
+            for (ssize_t done = 0; ok && done < n; ) {
+                ssize_t w = ::write(out, buf + done, n - done);
+                if (w < 0)
+                    ok = errno == EINTR;
+                else
+                    done += w;
+            }
+        }
+    }
+
+    ::close(in);
+    if (::close(out) != 0)
+        ok = false;
+
+    return ok;
+}
+
+Hash128 ObjectCache::key(const char *input, std::size_t size, std::string_view flags)
+{
+    Hash128 inputHash = hash128(input, size);
+
+    std::string salted((const char*)&inputHash, sizeof(inputHash));
+    salted += ASSEMBLER_VERSION;
+    salted += '\0';
+    salted += flags;
+
+    return hash128(salted.data(), salted.size());
+}
+
+bool ObjectCache::fetch(const Hash128& key, const std::string& outFilename) const
+{
+    return copyFile(path(key), outFilename);
+}
+
+bool ObjectCache::store(const Hash128& key, const std::string& objFilename) const
+{
+    static std::atomic<unsigned> tmpCounter(0);
+
+    if (::mkdir(dir_.c_str(), 0777) != 0 && errno != EEXIST)
+        return false;
+
+    // Unique per process and call, concurrent stores of one key are fine
+    std::string finalPath = path(key);
+    std::string tmpPath = finalPath + ".tmp." + std::to_string(::getpid())
+                          + "." + std::to_string(tmpCounter.fetch_add(1));
+
+    if (!copyFile(objFilename, tmpPath) || std::rename(tmpPath.c_str(), finalPath.c_str()) != 0) {
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+std::string ObjectCache::path(const Hash128& key) const
+{
+    return dir_ + "/" + key.hex() + ".o";
+}
@@ -0,0 +1,118 @@
+#include "output_file.hpp"
+
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+OutputFile::OutputFile() :
+    fd_(-1), memory_(false), mapped_(false), map_(nullptr), size_(0)
+{}
+
+OutputFile::~OutputFile()
+{
+    close();
+}
+
+bool OutputFile::open(const std::string& filename)
+{
+    close();
+
+    fd_ = ::open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0666);
+    if (fd_ < 0)
+        return false;
+
+    struct stat st;
+    mapped_ = ::fstat(fd_, &st) == 0 && S_ISREG(st.st_mode);
+
+    return true;
+}
+
+void OutputFile::openMemory()
+{
+    close();
+    memory_ = true;
+}
+
+std::vector<ubyte> OutputFile::release()
+{
+    std::vector<ubyte> contents;
+    if (memory_)
+        contents.swap(buffer_);
+    close();
+    return contents;
+}
+
+void OutputFile::resize(std::size_t size)
+{
+    if (mapped_ && ::ftruncate(fd_, size) == 0) {
+        // Shared file mapping, the current contents are in the file already
+        void *map = size ? ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0) : nullptr;
+        if (map != MAP_FAILED) {
+            if (map_)
+                ::munmap(map_, size_);
+            map_ = (ubyte*)map;
+            size_ = size;
+            return;
+        }
+    }
+
+    if (mapped_)
+        unmap();
+
+    buffer_.resize(size);
+    size_ = size;
+}
+
+void OutputFile::unmap()
+{
+    if (map_) {
+        buffer_.assign(map_, map_ + size_);
+        ::munmap(map_, size_);
+        map_ = nullptr;
+    }
+    mapped_ = false;
+}
+
+bool OutputFile::close()
+{
+    if (memory_) {
+        memory_ = false;
+        size_ = 0;
+        buffer_.clear();
+        return true;
+    }
+    if (fd_ < 0)
+        return true;
+
+    bool ok = true;
+
+    if (mapped_) {
+        if (map_)
+            ::munmap(map_, size_);
+    } else {
+        // The whole file in one write (loops only on short writes)
+        std::size_t done = 0;
+        while (ok && done < buffer_.size()) {
+            ssize_t n = ::write(fd_, buffer_.data() + done, buffer_.size() - done);
+            if (n < 0)
+                ok = errno == EINTR;
+            else
+                done += n;
+        }
+    }
+
+    if (::close(fd_) != 0)
+        ok = false;
+
+    fd_ = -1;
+    mapped_ = false;
+    map_ = nullptr;
+    size_ = 0;
+    buffer_.clear();
+
+    return ok;
+}
@@ -4,7 +4,9 @@
 
 %code requires {
 #include <string>
+#include <string_view>
 #include "types.hpp"
+#include "expr.hpp"
 
 namespace yy {
     class Lexer;
@@ -17,9 +19,9 @@ class Assembler;
 #include "parser.hpp"
 #include "assembler.hpp"
 
-yy::Parser::symbol_type yylex(yy::Lexer& lexer, Assembler& assembler)
+yy::Parser::symbol_type yylex(yy::Lexer&, Assembler& assembler)
 {
-    return lexer.get_token(assembler);
+    return assembler.nextToken();
 }
 
 #define PARSER_CALLBACK(X) { int r = X; if (r != AE_OK && r != AE_SYNTAX_NOSKIP) return r; }
@@ -39,25 +41,41 @@ yy::Parser::symbol_type yylex(yy::Lexer& lexer, Assembler& assembler)
 %define parse.error verbose
 %define parse.lac full
 
-%token <std::string> IDENT "identifier"
-%token <std::string> INT_10 "integer10"
-%token <std::string> INT_16 "integer16"
-%token <std::string> REG "register"
+%token <Atom> IDENT "identifier"
+%token <Literal> LITERAL "literal"
+%token <std::string_view> STRING "string"
+%token <Atom> REG "register"
 %token DOLLAR "$"
 %token PERCENT "%"
 %token COLON ":"
 %token COMMA ","
 %token PERIOD "."
 %token PLUS "+"
+%token MINUS "-"
 %token MUL "*"
+%token DIV "/"
+%token SHL "<<"
+%token SHR ">>"
+%token AND "&"
+%token OR "|"
+%token PAR_OPEN "("
+%token PAR_CLOSE ")"
 %token SBR_OPEN "["
 %token SBR_CLOSE "]"
 %token NEWLINE "newline"
 %token YYEOF 0 "end of file"
 %token YYUNDEF
 
-%type <std::string> label
+%type <Atom> label
 %type <ushort> literal
+%type <operand_variant> expr
+
+%left OR
+%left AND
+%left SHL SHR
+%left PLUS MINUS
+%left MUL DIV
+%precedence NEG
 
 %%
 asm:  stmt
@@ -74,13 +92,9 @@ instr: IDENT { PARSER_CALLBACK(assembler.instr($1)) }
     |  IDENT instr_arg { PARSER_CALLBACK(assembler.instr($1)) }
     |  IDENT instr_arg COMMA instr_arg { PARSER_CALLBACK(assembler.instr($1)) }
 
-instr_arg: DOLLAR literal                          /* $<literal>           */
-           { PARSER_CALLBACK(assembler.instrArgImmed($2)) }
-    |      DOLLAR IDENT                            /* $<symbol>            */
+instr_arg: DOLLAR expr                             /* $<expr>              */
            { PARSER_CALLBACK(assembler.instrArgImmed($2)) }
-    |      literal                                 /* <literal>            */
-           { PARSER_CALLBACK(assembler.instrArgMemDirOrJmpImmed($1)) }
-    |      IDENT                                   /* <symbol>             */
+    |      expr                                    /* <expr>               */
            { PARSER_CALLBACK(assembler.instrArgMemDirOrJmpImmed($1)) }
     |      PERCENT IDENT                           /* %<symbol>            */
            { PARSER_CALLBACK(assembler.instrArgPCRel($2)) }
@@ -88,21 +102,15 @@ instr_arg: DOLLAR literal                          /* $<literal>           */
            { PARSER_CALLBACK(assembler.instrArgRegDir($1)) }
     |      SBR_OPEN REG SBR_CLOSE                  /* [<reg>]              */
            { PARSER_CALLBACK(assembler.instrArgRegInd($2)) }
-    |      SBR_OPEN REG PLUS literal SBR_CLOSE     /* [<reg> + <literal>]  */
+    |      SBR_OPEN REG PLUS expr SBR_CLOSE        /* [<reg> + <expr>]     */
            { PARSER_CALLBACK(assembler.instrArgRegIndOff($2, $4)) }
-    |      SBR_OPEN REG PLUS IDENT SBR_CLOSE       /* [<reg> + <symbol>]   */
-           { PARSER_CALLBACK(assembler.instrArgRegIndOff($2, $4)) }
-    |      MUL literal                             /* *<literal>           */
-           { PARSER_CALLBACK(assembler.instrArgMemDirOrJmpImmed($2, true)) }
-    |      MUL IDENT                               /* *<symbol>            */
+    |      MUL expr                                /* *<expr>              */
            { PARSER_CALLBACK(assembler.instrArgMemDirOrJmpImmed($2, true)) }
     |      MUL REG                                 /* *<reg>               */
            { PARSER_CALLBACK(assembler.instrArgRegDir($2, true)) }
     |      MUL SBR_OPEN REG SBR_CLOSE              /* *[<reg>]             */
            { PARSER_CALLBACK(assembler.instrArgRegInd($3, true)) }
-    |      MUL SBR_OPEN REG PLUS literal SBR_CLOSE /* *[<reg> + <literal>] */
-           { PARSER_CALLBACK(assembler.instrArgRegIndOff($3, $5, true)) }
-    |      MUL SBR_OPEN REG PLUS IDENT SBR_CLOSE   /* *[<reg> + <symbol>]  */
+    |      MUL SBR_OPEN REG PLUS expr SBR_CLOSE    /* *[<reg> + <expr>]    */
            { PARSER_CALLBACK(assembler.instrArgRegIndOff($3, $5, true)) }
 
 dir:  PERIOD IDENT { PARSER_CALLBACK(assembler.dir($2)) }
@@ -111,33 +119,42 @@ dir:  PERIOD IDENT { PARSER_CALLBACK(assembler.dir($2)) }
 dir_arg_list: dir_arg
     | dir_arg_list COMMA dir_arg
 
-dir_arg: IDENT { PARSER_CALLBACK(assembler.dirArg($1)) }
-    |    literal { PARSER_CALLBACK(assembler.dirArg($1)) }
-
-literal: INT_10 {
-           uint lit = std::stoul($1, nullptr, 10);
-           if (lit > 0xFFFFul) {
-              error(assembler.getLocation(), "syntax error, literal value outside bounds: " + $1);
+dir_arg: expr { PARSER_CALLBACK(assembler.dirArg($1)) }
+    |    STRING { PARSER_CALLBACK(assembler.dirArgString($1)) }
+
+/* A literal stays a literal and a lone symbol a symbol, operators on
+   literals are folded */
+expr: literal { $$ = $1; }
+    | IDENT { $$ = $1; }
+    | PAR_OPEN expr PAR_CLOSE { $$ = $2; }
+    | MINUS expr %prec NEG { $$ = assembler.exprOp(EXPR_NEG, $2); }
+    | expr PLUS expr { $$ = assembler.exprOp(EXPR_ADD, $1, $3); }
+    | expr MINUS expr { $$ = assembler.exprOp(EXPR_SUB, $1, $3); }
+    | expr MUL expr { $$ = assembler.exprOp(EXPR_MUL, $1, $3); }
+    | expr DIV expr { $$ = assembler.exprOp(EXPR_DIV, $1, $3); }
+    | expr SHL expr { $$ = assembler.exprOp(EXPR_SHL, $1, $3); }
+    | expr SHR expr { $$ = assembler.exprOp(EXPR_SHR, $1, $3); }
+    | expr AND expr { $$ = assembler.exprOp(EXPR_AND, $1, $3); }
+    | expr OR expr { $$ = assembler.exprOp(EXPR_OR, $1, $3); }
+
+literal: LITERAL {
+           if ($1.overflow) {
+              error(assembler.getLocation(), "syntax error, literal value outside bounds: " + std::string($1.text));
               return 1;
            }
-           $$ = (ushort)lit;
-         }
-
-    |    INT_16 {
-           uint lit = std::stoul($1, nullptr, 16);
-           if (lit > 0xFFFFul) {
-             error(assembler.getLocation(), "syntax error, literal value outside bounds: " + $1);
-             return 1;
-           }
-           $$ = (ushort)lit;
+           $$ = $1.value;
          }
 
 label: IDENT COLON { PARSER_CALLBACK(assembler.label($1)); }
 %%
 
-#include <iostream>
-
 void yy::Parser::error(const yy::Parser::location_type& loc, const std::string& msg)
 {
-	std::cout << *loc.begin.filename << ":" << loc.begin.line << ":" << loc.begin.column  << ": " << msg << std::endl;
+	// Bison messages start with "syntax error", the rest is the detail
+	std::string_view detail = msg;
+	if (detail.substr(0, 12) == "syntax error")
+		detail.remove_prefix(12);
+	if (detail.substr(0, 2) == ", ")
+		detail.remove_prefix(2);
+	assembler.report(DIAG_SYNTAX_ERROR, loc, std::string(detail));
 }
@@ -0,0 +1,333 @@
+#include "server.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <iterator>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// Larger request fields are refused instead of allocated
+const uint MAX_FIELD_SIZE = 1u << 30;
+
+namespace
+{
+
+bool readAll(int fd, void *data, std::size_t size)
+{
+    char *p = (char*)data;
+    while (size) {
+        ssize_t n = ::recv(fd, p, size, 0);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return false;
+        p += n;
+        size -= n;
+    }
+    return true;
+}
+
+bool writeAll(int fd, const void *data, std::size_t size)
+{
+    const char *p = (const char*)data;
+    while (size) {
+        ssize_t n = ::send(fd, p, size, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return false;
+        p += n;
+        size -= n;
+    }
+    return true;
+}
+
+bool readField(int fd, uint size, std::string &field)
+{
+    if (size > MAX_FIELD_SIZE)
+        return false;
+    field.resize(size);
+    return readAll(fd, field.data(), size);
+}
+
+bool socketAddress(const std::string& path, sockaddr_un &addr)
+{
+    if (path.empty() || path.size() >= sizeof(addr.sun_path))
+        return false;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+    return true;
+}
+
+int connectTo(const std::string& path)
+{
+    sockaddr_un addr;
+    if (!socketAddress(path, addr))
+        return -1;
+    int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+        return -1;
+    if (::connect(fd, (const sockaddr*)&addr, sizeof(addr)) != 0) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+int listenOn(const std::string& path)
+{
+    sockaddr_un addr;
+    if (!socketAddress(path, addr))
+        return -1;
+
+    // A socket nobody answers on is left over from a previous server
+    int running = connectTo(path);
+    if (running >= 0) {
+        ::close(running);
+        return -1;
+    }
+    ::unlink(path.c_str());
+
+    int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+        return -1;
+    if (::bind(fd, (const sockaddr*)&addr, sizeof(addr)) != 0 || ::listen(fd, SOMAXCONN) != 0) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Accepted connections waiting for a worker
+class ConnectionQueue
+{
+public:
+    void push(int fd)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        fds_.push_back(fd);
+        cond_.notify_one();
+    }
+
+    // -1 once closed and empty
+    int pop()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cond_.wait(lock, [this] { return closed_ || !fds_.empty(); });
+        if (fds_.empty())
+            return -1;
+        int fd = fds_.front();
+        fds_.pop_front();
+        return fd;
+    }
+
+    void close()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+        cond_.notify_all();
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::deque<int> fds_;
+    bool closed_ = false;
+};
+
+// Server side of one worker: its Assembler and the request buffers are
+// reused for every job
+class Worker
+{
+public:
+    explicit Worker(const AssemblerOptions& options) :
+        assembler_(options), flags_(options.outputFlags())
+    {
+        assembler_.setDiagnostics(diagnostics_);
+    }
+
+    // Serve requests on fd until the client disconnects, false on a shutdown request
+    bool serve(int fd)
+    {
+        ServerRequest request;
+        while (readAll(fd, &request, sizeof(request))) {
+            if (request.magic != SERVER_MAGIC)
+                break;
+            if (request.type == REQ_SHUTDOWN)
+                return false;
+
+            if (!readField(fd, request.flagsSize, requestFlags_)
+                || !readField(fd, request.sourceSize, source_)
+                || !readField(fd, request.sourceNameSize, sourceName_)
+                || !readField(fd, request.outFilenameSize, outFilename_))
+                break;
+
+            diagnostics_.str(std::string());
+            ServerResponse response;
+            if (requestFlags_ != flags_) {
+                diagnostics_ << "Server options differ (server: '" << flags_ << "', client: '"
+                             << requestFlags_ << "')" << std::endl;
+                response.res = AE_FILE;
+            } else if (request.type == REQ_FILE)
+                response.res = assembler_.run(source_, outFilename_);
+            else
+                response.res = assembler_.run(source_, sourceName_, outFilename_);
+
+            std::string diagnostics = diagnostics_.str();
+            response.diagnosticsSize = diagnostics.size();
+            if (!writeAll(fd, &response, sizeof(response))
+                || !writeAll(fd, diagnostics.data(), diagnostics.size()))
+                break;
+        }
+        return true;
+    }
+
+private:
+    Assembler assembler_;
+    std::string flags_;
+    std::ostringstream diagnostics_;
+    std::string requestFlags_;
+    std::string source_;
+    std::string sourceName_;
+    std::string outFilename_;
+};
+
+std::string absolutePath(const std::string& path)
+{
+    if (path.empty() || path[0] == '/')
+        return path;
+    char cwd[4096];
+    if (!::getcwd(cwd, sizeof(cwd)))
+        return path;
+    return std::string(cwd) + "/" + path;
+}
+
+bool sendRequest(int fd, ServerRequest request, const std::string& flags, std::string_view source,
+                 const std::string& sourceName, const std::string& outFilename)
+{
+    request.flagsSize = flags.size();
+    request.sourceSize = source.size();
+    request.sourceNameSize = sourceName.size();
+    request.outFilenameSize = outFilename.size();
+    return writeAll(fd, &request, sizeof(request))
+        && writeAll(fd, flags.data(), flags.size())
+        && writeAll(fd, source.data(), source.size())
+        && writeAll(fd, sourceName.data(), sourceName.size())
+        && writeAll(fd, outFilename.data(), outFilename.size());
+}
+
+}
+
+int runServer(const std::string& socketPath, const AssemblerOptions& options,
+              unsigned workers, std::ostream& out)
+{
+    int listenFd = listenOn(socketPath);
+    if (listenFd < 0) {
+        out << "Cannot listen on socket: " << socketPath << std::endl;
+        return AE_FILE;
+    }
+
+    ConnectionQueue connections;
+    std::atomic<bool> stopping(false);
+
+    auto worker = [&]() {
+        Worker worker(options);
+        int fd;
+        while ((fd = connections.pop()) >= 0) {
+            bool keepRunning = worker.serve(fd);
+            ::close(fd);
+            if (!keepRunning && !stopping.exchange(true))
+                ::shutdown(listenFd, SHUT_RDWR); // wakes up accept
+        }
+    };
+
+    workers = std::max(1u, workers);
+    std::vector<std::thread> threads;
+    threads.reserve(workers);
+    for (unsigned w = 0; w < workers; ++w)
+        threads.emplace_back(worker);
+
+    while (!stopping.load()) {
+        int fd = ::accept4(listenFd, nullptr, nullptr, SOCK_CLOEXEC);
+        if (fd >= 0)
+            connections.push(fd);
+        else if (errno != EINTR && errno != ECONNABORTED)
+            break;
+    }
+
+    // Connections already accepted are served before the workers stop
+    connections.close();
+    for (std::thread& thread : threads)
+        thread.join();
+
+    ::close(listenFd);
+    ::unlink(socketPath.c_str());
+    return AE_OK;
+}
+
+int runClient(const std::string& socketPath, const std::vector<BatchJob>& jobs,
+              const AssemblerOptions& options, std::ostream& out)
+{
+    int fd = connectTo(socketPath);
+    if (fd < 0) {
+        out << "Cannot connect to server: " << socketPath << std::endl;
+        return AE_FILE;
+    }
+
+    const std::string flags = options.outputFlags();
+    std::string stdinSource, diagnostics;
+    int res = AE_OK;
+
+    for (const BatchJob& job : jobs) {
+        ServerRequest request;
+        bool sent;
+        if (job.inFilename == "-") {
+            if (stdinSource.empty())
+                stdinSource.assign(std::istreambuf_iterator<char>(std::cin), std::istreambuf_iterator<char>());
+            request.type = REQ_SOURCE;
+            sent = sendRequest(fd, request, flags, stdinSource, "<stdin>", absolutePath(job.outFilename));
+        } else
+            sent = sendRequest(fd, request, flags, absolutePath(job.inFilename), std::string(),
+                               absolutePath(job.outFilename));
+
+        ServerResponse response;
+        if (!sent || !readAll(fd, &response, sizeof(response)) || response.magic != SERVER_MAGIC
+            || !readField(fd, response.diagnosticsSize, diagnostics)) {
+            out << "Lost connection to server: " << socketPath << std::endl;
+            res = AE_FILE;
+            break;
+        }
+
+        out << diagnostics << std::flush;
+        res = std::max(res, response.res);
+    }
+
+    ::close(fd);
+    return res;
+}
+
+int stopServer(const std::string& socketPath, std::ostream& out)
+{
+    int fd = connectTo(socketPath);
+    if (fd < 0) {
+        out << "Cannot connect to server: " << socketPath << std::endl;
+        return AE_FILE;
+    }
+
+    ServerRequest request;
+    request.type = REQ_SHUTDOWN;
+    bool sent = writeAll(fd, &request, sizeof(request));
+    ::close(fd);
+    return sent ? AE_OK : AE_FILE;
+}
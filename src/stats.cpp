@@ -0,0 +1,137 @@
+#include "stats.hpp"
+
+#include <cstdio>
+#include <ctime>
+
+#include <sys/resource.h>
+
+static const char *const REL_TYPE_NAMES[NUM_REL_TYPES] = { "sym16", "sym16_be", "pc" };
+
+double threadCpuSeconds()
+{
+    timespec ts;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0)
+        return 0;
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+long peakRssKb()
+{
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+    return usage.ru_maxrss;
+}
+
+static std::string jsonString(const std::string& str)
+{
+    std::string out = "\"";
+    for (char c : str) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if ((unsigned char)c < 0x20) {
+            char escape[8];
+            std::snprintf(escape, sizeof(escape), "\\u%04x", c);
+            out += escape;
+        } else
+            out += c;
+    }
+    return out + '"';
+}
+
+// Calls f(name, count) for every instruction with a nonzero count
+template<typename F>
+static void forEachInstruction(const AssemblerStats& stats, F f)
+{
+    for (std::size_t i = 0; i < NUM_INSTRUCTIONS; ++i)
+        if (stats.instructions[i])
+            f(INSTRUCTIONS.begin()[i].key, stats.instructions[i]);
+}
+
+template<typename F>
+static void forEachDirective(const AssemblerStats& stats, F f)
+{
+    for (const StaticMapEntry<DirInfo>& entry : DIRECTIVES)
+        if (stats.directives[entry.value.dir])
+            f(entry.key, stats.directives[entry.value.dir]);
+}
+
+static void printText(std::ostream& out, const AssemblerStats& stats, const std::string& filename)
+{
+    out << "stats: " << filename << (stats.cached ? " (cached)" : "") << "\n";
+
+    char line[96];
+    std::snprintf(line, sizeof(line), "  %-8s %10s %10s\n", "phase", "wall ms", "cpu ms");
+    out << line;
+    for (int p = 0; p < NUM_PHASES; ++p) {
+        std::snprintf(line, sizeof(line), "  %-8s %10.3f %10.3f\n", PHASE_NAMES[p],
+                      stats.wall[p] * 1e3, stats.cpu[p] * 1e3);
+        out << line;
+    }
+
+    out << "  lines " << stats.lines << ", tokens " << stats.tokens << ", symbols " << stats.symbols
+        << " (section symbols " << stats.sectionSymbols << ")\n";
+
+    out << "  instructions:";
+    forEachInstruction(stats, [&out](std::string_view name, std::size_t count) {
+        out << ' ' << name << ' ' << count;
+    });
+    out << "\n  directives:";
+    forEachDirective(stats, [&out](std::string_view name, std::size_t count) {
+        out << ' ' << name << ' ' << count;
+    });
+    out << "\n  relocations:";
+    for (std::size_t t = 0; t < NUM_REL_TYPES; ++t)
+        out << ' ' << REL_TYPE_NAMES[t] << ' ' << stats.relocations[t];
+    out << " (pc resolved " << stats.resolvedPcRelocations << ")";
+    out << "\n  peephole: removed instructions " << stats.removedInstructions
+        << ", threaded jumps " << stats.threadedJumps;
+    out << "\n  headers: precompiled " << stats.precompiledHeaders << " (cached " << stats.cachedHeaders << ")";
+
+    out << "\n  heap allocations " << stats.heapAllocations << ", peak rss " << stats.peakRssKb << " KB\n";
+}
+
+static void printJson(std::ostream& out, const AssemblerStats& stats, const std::string& filename)
+{
+    out << "{\"file\": " << jsonString(filename) << ", \"cached\": " << (stats.cached ? "true" : "false")
+        << ", \"phases\": {";
+    for (int p = 0; p < NUM_PHASES; ++p)
+        out << (p ? ", \"" : "\"") << PHASE_NAMES[p] << "\": {\"wall_s\": " << stats.wall[p]
+            << ", \"cpu_s\": " << stats.cpu[p] << "}";
+
+    out << "}, \"lines\": " << stats.lines << ", \"tokens\": " << stats.tokens
+        << ", \"symbols\": " << stats.symbols << ", \"section_symbols\": " << stats.sectionSymbols;
+
+    const char *sep = "";
+    out << ", \"instructions\": {";
+    forEachInstruction(stats, [&out, &sep](std::string_view name, std::size_t count) {
+        out << sep << '"' << name << "\": " << count;
+        sep = ", ";
+    });
+    sep = "";
+    out << "}, \"directives\": {";
+    forEachDirective(stats, [&out, &sep](std::string_view name, std::size_t count) {
+        out << sep << '"' << name << "\": " << count;
+        sep = ", ";
+    });
+    out << "}, \"relocations\": {";
+    for (std::size_t t = 0; t < NUM_REL_TYPES; ++t)
+        out << (t ? ", \"" : "\"") << REL_TYPE_NAMES[t] << "\": " << stats.relocations[t];
+    out << "}, \"resolved_pc_relocations\": " << stats.resolvedPcRelocations;
+    out << ", \"removed_instructions\": " << stats.removedInstructions
+        << ", \"threaded_jumps\": " << stats.threadedJumps
+        << ", \"precompiled_headers\": " << stats.precompiledHeaders
+        << ", \"cached_headers\": " << stats.cachedHeaders;
+
+    out << ", \"heap_allocations\": " << stats.heapAllocations
+        << ", \"peak_rss_kb\": " << stats.peakRssKb << "}\n";
+}
+
+void printStats(std::ostream& out, const AssemblerStats& stats, const std::string& filename, StatsFormat format)
+{
+    if (format == STATS_TEXT)
+        printText(out, stats, filename);
+    else if (format == STATS_JSON)
+        printJson(out, stats, filename);
+}
@@ -0,0 +1,12 @@
+# run:
+# run: --single-pass
+# label - label is absolute only within one section
+.section text
+one: .word 1
+two: .word 2
+.word two - one             # 2
+.section data
+three: .word 3
+.word three - one           # rejected
+.word one - three + 1       # rejected
+.end
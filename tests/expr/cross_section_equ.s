@@ -0,0 +1,10 @@
+# run:
+# A .equ that is a difference of labels in different sections is rejected
+.section text
+one: .word 1
+two: .word 2
+.equ dist, two - one
+.equ bad, three - two
+.section data
+three: .word dist, bad
+.end
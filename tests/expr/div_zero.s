@@ -0,0 +1,10 @@
+# run:
+# run: --single-pass
+# Division by zero through a .equ, reported when the value is evaluated
+.equ zero, 0
+.equ half, zero / 2
+.section data
+.word half
+.word 4 / zero
+.word 8 / (zero * 3) + 1
+.end
@@ -0,0 +1,7 @@
+# run:
+# Division by zero on literals, reported by the parser while folding
+.section data
+.word 1 / 0
+.word 2 / (1 - 1)
+.word 3 / 1
+.end
@@ -0,0 +1,9 @@
+# run:
+# A .equ cycle is reported once, with its path
+.equ a, b + 1
+.equ b, c
+.equ c, a * 2
+.equ d, d
+.section data
+.word a
+.end
@@ -0,0 +1,14 @@
+# run:
+# run: --single-pass
+# A .equ may use a .equ defined later in the source, or a label
+.equ total, base + count * 2
+.equ base, 0x100
+.equ count, last
+.equ last, 3
+.equ here, start + 4
+.global total, here
+.section code
+start: jmp here
+halt
+.word total
+.end
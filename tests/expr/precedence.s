@@ -0,0 +1,20 @@
+# run:
+# run: --single-pass
+# Operator precedence and folding: each word is folded to the constant in
+# its comment, with no relocation
+.section data
+.word 1 + 2 * 3             # 7
+.word (1 + 2) * 3           # 9
+.word 1 << 2 + 1            # 8, shifts bind looser than +
+.word 6 & 3 | 8             # 10, & before |
+.word 0x10 >> 2 - 1         # 8
+.word -1                    # 0xFFFF
+.word -(2 + 3) * 2          # 0xFFF6
+.word 100 / 7 * 7           # 98
+.word 0xFFFF + 2            # 1, wraps
+.equ five, 2 + 3
+.equ ten, five * 2
+.word ten - five / 5 << 1   # 18
+.section code
+ldr r1, $ten + 1            # operand folded too
+.end
@@ -0,0 +1,12 @@
+# run:
+# run: --single-pass
+# .incbin "file"[, offset[, length]] within the 8 bytes of data.bin (01..08)
+.section data
+all: .incbin "data.bin"
+tail: .incbin "data.bin", 5
+part: .incbin "data.bin", 2, 3
+none: .incbin "data.bin", 8
+.incbin "data.bin", 8, 0
+.incbin "data.bin", 0, 8
+end: .word all, tail, part, none, end
+.end
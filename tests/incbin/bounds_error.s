@@ -0,0 +1,10 @@
+# run:
+# .incbin offsets and lengths past the end of the file are errors
+.section data
+.incbin "data.bin", 9
+.incbin "data.bin", 4, 5
+.incbin "data.bin", 8, 1
+.incbin "missing.bin"
+.incbin "data.bin", 0, 1, 2
+.incbin "data.bin", 7, 1
+.end
@@ -0,0 +1,8 @@
+# run: --memory
+# A source passed as bytes has no directory: relative .incbin and .include
+# paths are errors rather than files of the working directory
+.section data
+.incbin "data.bin"
+.include "data.bin"
+.word 1
+.end
@@ -0,0 +1,7 @@
+# run:
+# A .equ cycle in an included file is reported in that file, though it
+# is found at .end
+.section data
+.word loop_a
+.include "equ_cycle.inc"
+.end
@@ -0,0 +1,7 @@
+# run:
+# Errors in a precompiled header are located in it, as in a plain include
+.section data
+.word 1
+.include "dup.inc"
+.include "dup_plain.inc"
+.end
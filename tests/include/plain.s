@@ -0,0 +1,15 @@
+# run:
+# run: --single-pass
+# same-object: include/precompiled.s
+# decls_plain.inc is included as tokens
+.include "decls_plain.inc"
+.section code
+main:
+    ldr r1, $SIZE
+    ldr r2, $MASK
+    call putc
+    call %getc
+    halt
+.section data
+.word SIZE, MASK, main
+.end
@@ -0,0 +1,15 @@
+# run:
+# run: --single-pass
+# same-object: include/plain.s
+# decls.inc is precompiled, the object matches the one built from tokens
+.include "decls.inc"
+.section code
+main:
+    ldr r1, $SIZE
+    ldr r2, $MASK
+    call putc
+    call %getc
+    halt
+.section data
+.word SIZE, MASK, main
+.end
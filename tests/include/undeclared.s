@@ -0,0 +1,10 @@
+# run:
+# run: --single-pass
+# Errors found after parsing (undeclared symbols, bad expressions) are
+# reported in the file that holds the reference
+.section data
+.word undeclared_main
+.include "undeclared.inc"
+.section data2
+.word undeclared_after
+.end
@@ -0,0 +1,12 @@
+# Decimal and hex literals decoded by the lexer, in both byte orders
+# run:
+# run: --single-pass
+.section data
+    .word 0, 1, 255, 256, 65535, 00012, 0000000000000000065535
+    .word 0x0, 0x1, 0xff, 0x100, 0xffff, 0XABCD, 0xaBcD, 0x00000000000000001
+.section code
+    ldr r0, $65535
+    ldr r1, $0xBEEF
+    ldr r2, 0x1234
+    ldr r3, [r4 + 4096]
+.end
@@ -0,0 +1,406 @@
+# Input several times the size of the scanner buffer: tokens, literals
+# and their text are read across buffer refills
+.global table
+.section data
+table:
+    .word 0, 0x0 # padding to push the following tokens past the scanner buffer  line 0
+    .word 163, 0x9E37 # padding to push the following tokens past the scanner buffer  line 1
+    .word 326, 0x3C6E # padding to push the following tokens past the scanner buffer  line 2
+    .word 489, 0xDAA5 # padding to push the following tokens past the scanner buffer  line 3
+    .word 652, 0x78DC # padding to push the following tokens past the scanner buffer  line 4
+    .word 815, 0x1713 # padding to push the following tokens past the scanner buffer  line 5
+    .word 978, 0xB54A # padding to push the following tokens past the scanner buffer  line 6
+    .word 1141, 0x5381 # padding to push the following tokens past the scanner buffer  line 7
+    .word 1304, 0xF1B8 # padding to push the following tokens past the scanner buffer  line 8
+    .word 1467, 0x8FEF # padding to push the following tokens past the scanner buffer  line 9
+    .word 1630, 0x2E26 # padding to push the following tokens past the scanner buffer  line 10
+    .word 1793, 0xCC5D # padding to push the following tokens past the scanner buffer  line 11
+    .word 1956, 0x6A94 # padding to push the following tokens past the scanner buffer  line 12
+    .word 2119, 0x8CB # padding to push the following tokens past the scanner buffer  line 13
+    .word 2282, 0xA702 # padding to push the following tokens past the scanner buffer  line 14
+    .word 2445, 0x4539 # padding to push the following tokens past the scanner buffer  line 15
+    .word 2608, 0xE370 # padding to push the following tokens past the scanner buffer  line 16
+    .word 2771, 0x81A7 # padding to push the following tokens past the scanner buffer  line 17
+    .word 2934, 0x1FDE # padding to push the following tokens past the scanner buffer  line 18
+    .word 3097, 0xBE15 # padding to push the following tokens past the scanner buffer  line 19
+    .word 3260, 0x5C4C # padding to push the following tokens past the scanner buffer  line 20
+    .word 3423, 0xFA83 # padding to push the following tokens past the scanner buffer  line 21
+    .word 3586, 0x98BA # padding to push the following tokens past the scanner buffer  line 22
+    .word 3749, 0x36F1 # padding to push the following tokens past the scanner buffer  line 23
+    .word 3912, 0xD528 # padding to push the following tokens past the scanner buffer  line 24
+    .word 4075, 0x735F # padding to push the following tokens past the scanner buffer  line 25
+    .word 4238, 0x1196 # padding to push the following tokens past the scanner buffer  line 26
+    .word 4401, 0xAFCD # padding to push the following tokens past the scanner buffer  line 27
+    .word 4564, 0x4E04 # padding to push the following tokens past the scanner buffer  line 28
+    .word 4727, 0xEC3B # padding to push the following tokens past the scanner buffer  line 29
+    .word 4890, 0x8A72 # padding to push the following tokens past the scanner buffer  line 30
+    .word 5053, 0x28A9 # padding to push the following tokens past the scanner buffer  line 31
+    .word 5216, 0xC6E0 # padding to push the following tokens past the scanner buffer  line 32
+    .word 5379, 0x6517 # padding to push the following tokens past the scanner buffer  line 33
+    .word 5542, 0x34E # padding to push the following tokens past the scanner buffer  line 34
+    .word 5705, 0xA185 # padding to push the following tokens past the scanner buffer  line 35
+    .word 5868, 0x3FBC # padding to push the following tokens past the scanner buffer  line 36
+    .word 6031, 0xDDF3 # padding to push the following tokens past the scanner buffer  line 37
+    .word 6194, 0x7C2A # padding to push the following tokens past the scanner buffer  line 38
+    .word 6357, 0x1A61 # padding to push the following tokens past the scanner buffer  line 39
+    .word 6520, 0xB898 # padding to push the following tokens past the scanner buffer  line 40
+    .word 6683, 0x56CF # padding to push the following tokens past the scanner buffer  line 41
+    .word 6846, 0xF506 # padding to push the following tokens past the scanner buffer  line 42
+    .word 7009, 0x933D # padding to push the following tokens past the scanner buffer  line 43
+    .word 7172, 0x3174 # padding to push the following tokens past the scanner buffer  line 44
+    .word 7335, 0xCFAB # padding to push the following tokens past the scanner buffer  line 45
+    .word 7498, 0x6DE2 # padding to push the following tokens past the scanner buffer  line 46
+    .word 7661, 0xC19 # padding to push the following tokens past the scanner buffer  line 47
+    .word 7824, 0xAA50 # padding to push the following tokens past the scanner buffer  line 48
+    .word 7987, 0x4887 # padding to push the following tokens past the scanner buffer  line 49
+    .word 8150, 0xE6BE # padding to push the following tokens past the scanner buffer  line 50
+    .word 8313, 0x84F5 # padding to push the following tokens past the scanner buffer  line 51
+    .word 8476, 0x232C # padding to push the following tokens past the scanner buffer  line 52
+    .word 8639, 0xC163 # padding to push the following tokens past the scanner buffer  line 53
+    .word 8802, 0x5F9A # padding to push the following tokens past the scanner buffer  line 54
+    .word 8965, 0xFDD1 # padding to push the following tokens past the scanner buffer  line 55
+    .word 9128, 0x9C08 # padding to push the following tokens past the scanner buffer  line 56
+    .word 9291, 0x3A3F # padding to push the following tokens past the scanner buffer  line 57
+    .word 9454, 0xD876 # padding to push the following tokens past the scanner buffer  line 58
+    .word 9617, 0x76AD # padding to push the following tokens past the scanner buffer  line 59
+    .word 9780, 0x14E4 # padding to push the following tokens past the scanner buffer  line 60
+    .word 9943, 0xB31B # padding to push the following tokens past the scanner buffer  line 61
+    .word 10106, 0x5152 # padding to push the following tokens past the scanner buffer  line 62
+    .word 10269, 0xEF89 # padding to push the following tokens past the scanner buffer  line 63
+    .word 10432, 0x8DC0 # padding to push the following tokens past the scanner buffer  line 64
+    .word 10595, 0x2BF7 # padding to push the following tokens past the scanner buffer  line 65
+    .word 10758, 0xCA2E # padding to push the following tokens past the scanner buffer  line 66
+    .word 10921, 0x6865 # padding to push the following tokens past the scanner buffer  line 67
+    .word 11084, 0x69C # padding to push the following tokens past the scanner buffer  line 68
+    .word 11247, 0xA4D3 # padding to push the following tokens past the scanner buffer  line 69
+    .word 11410, 0x430A # padding to push the following tokens past the scanner buffer  line 70
+    .word 11573, 0xE141 # padding to push the following tokens past the scanner buffer  line 71
+    .word 11736, 0x7F78 # padding to push the following tokens past the scanner buffer  line 72
+    .word 11899, 0x1DAF # padding to push the following tokens past the scanner buffer  line 73
+    .word 12062, 0xBBE6 # padding to push the following tokens past the scanner buffer  line 74
+    .word 12225, 0x5A1D # padding to push the following tokens past the scanner buffer  line 75
+    .word 12388, 0xF854 # padding to push the following tokens past the scanner buffer  line 76
+    .word 12551, 0x968B # padding to push the following tokens past the scanner buffer  line 77
+    .word 12714, 0x34C2 # padding to push the following tokens past the scanner buffer  line 78
+    .word 12877, 0xD2F9 # padding to push the following tokens past the scanner buffer  line 79
+    .word 13040, 0x7130 # padding to push the following tokens past the scanner buffer  line 80
+    .word 13203, 0xF67 # padding to push the following tokens past the scanner buffer  line 81
+    .word 13366, 0xAD9E # padding to push the following tokens past the scanner buffer  line 82
+    .word 13529, 0x4BD5 # padding to push the following tokens past the scanner buffer  line 83
+    .word 13692, 0xEA0C # padding to push the following tokens past the scanner buffer  line 84
+    .word 13855, 0x8843 # padding to push the following tokens past the scanner buffer  line 85
+    .word 14018, 0x267A # padding to push the following tokens past the scanner buffer  line 86
+    .word 14181, 0xC4B1 # padding to push the following tokens past the scanner buffer  line 87
+    .word 14344, 0x62E8 # padding to push the following tokens past the scanner buffer  line 88
+    .word 14507, 0x11F # padding to push the following tokens past the scanner buffer  line 89
+    .word 14670, 0x9F56 # padding to push the following tokens past the scanner buffer  line 90
+    .word 14833, 0x3D8D # padding to push the following tokens past the scanner buffer  line 91
+    .word 14996, 0xDBC4 # padding to push the following tokens past the scanner buffer  line 92
+    .word 15159, 0x79FB # padding to push the following tokens past the scanner buffer  line 93
+    .word 15322, 0x1832 # padding to push the following tokens past the scanner buffer  line 94
+    .word 15485, 0xB669 # padding to push the following tokens past the scanner buffer  line 95
+    .word 15648, 0x54A0 # padding to push the following tokens past the scanner buffer  line 96
+    .word 15811, 0xF2D7 # padding to push the following tokens past the scanner buffer  line 97
+    .word 15974, 0x910E # padding to push the following tokens past the scanner buffer  line 98
+    .word 16137, 0x2F45 # padding to push the following tokens past the scanner buffer  line 99
+    .word 16300, 0xCD7C # padding to push the following tokens past the scanner buffer  line 100
+    .word 16463, 0x6BB3 # padding to push the following tokens past the scanner buffer  line 101
+    .word 16626, 0x9EA # padding to push the following tokens past the scanner buffer  line 102
+    .word 16789, 0xA821 # padding to push the following tokens past the scanner buffer  line 103
+    .word 16952, 0x4658 # padding to push the following tokens past the scanner buffer  line 104
+    .word 17115, 0xE48F # padding to push the following tokens past the scanner buffer  line 105
+    .word 17278, 0x82C6 # padding to push the following tokens past the scanner buffer  line 106
+    .word 17441, 0x20FD # padding to push the following tokens past the scanner buffer  line 107
+    .word 17604, 0xBF34 # padding to push the following tokens past the scanner buffer  line 108
+    .word 17767, 0x5D6B # padding to push the following tokens past the scanner buffer  line 109
+    .word 17930, 0xFBA2 # padding to push the following tokens past the scanner buffer  line 110
+    .word 18093, 0x99D9 # padding to push the following tokens past the scanner buffer  line 111
+    .word 18256, 0x3810 # padding to push the following tokens past the scanner buffer  line 112
+    .word 18419, 0xD647 # padding to push the following tokens past the scanner buffer  line 113
+    .word 18582, 0x747E # padding to push the following tokens past the scanner buffer  line 114
+    .word 18745, 0x12B5 # padding to push the following tokens past the scanner buffer  line 115
+    .word 18908, 0xB0EC # padding to push the following tokens past the scanner buffer  line 116
+    .word 19071, 0x4F23 # padding to push the following tokens past the scanner buffer  line 117
+    .word 19234, 0xED5A # padding to push the following tokens past the scanner buffer  line 118
+    .word 19397, 0x8B91 # padding to push the following tokens past the scanner buffer  line 119
+    .word 19560, 0x29C8 # padding to push the following tokens past the scanner buffer  line 120
+    .word 19723, 0xC7FF # padding to push the following tokens past the scanner buffer  line 121
+    .word 19886, 0x6636 # padding to push the following tokens past the scanner buffer  line 122
+    .word 20049, 0x46D # padding to push the following tokens past the scanner buffer  line 123
+    .word 20212, 0xA2A4 # padding to push the following tokens past the scanner buffer  line 124
+    .word 20375, 0x40DB # padding to push the following tokens past the scanner buffer  line 125
+    .word 20538, 0xDF12 # padding to push the following tokens past the scanner buffer  line 126
+    .word 20701, 0x7D49 # padding to push the following tokens past the scanner buffer  line 127
+    .word 20864, 0x1B80 # padding to push the following tokens past the scanner buffer  line 128
+    .word 21027, 0xB9B7 # padding to push the following tokens past the scanner buffer  line 129
+    .word 21190, 0x57EE # padding to push the following tokens past the scanner buffer  line 130
+    .word 21353, 0xF625 # padding to push the following tokens past the scanner buffer  line 131
+    .word 21516, 0x945C # padding to push the following tokens past the scanner buffer  line 132
+    .word 21679, 0x3293 # padding to push the following tokens past the scanner buffer  line 133
+    .word 21842, 0xD0CA # padding to push the following tokens past the scanner buffer  line 134
+    .word 22005, 0x6F01 # padding to push the following tokens past the scanner buffer  line 135
+    .word 22168, 0xD38 # padding to push the following tokens past the scanner buffer  line 136
+    .word 22331, 0xAB6F # padding to push the following tokens past the scanner buffer  line 137
+    .word 22494, 0x49A6 # padding to push the following tokens past the scanner buffer  line 138
+    .word 22657, 0xE7DD # padding to push the following tokens past the scanner buffer  line 139
+    .word 22820, 0x8614 # padding to push the following tokens past the scanner buffer  line 140
+    .word 22983, 0x244B # padding to push the following tokens past the scanner buffer  line 141
+    .word 23146, 0xC282 # padding to push the following tokens past the scanner buffer  line 142
+    .word 23309, 0x60B9 # padding to push the following tokens past the scanner buffer  line 143
+    .word 23472, 0xFEF0 # padding to push the following tokens past the scanner buffer  line 144
+    .word 23635, 0x9D27 # padding to push the following tokens past the scanner buffer  line 145
+    .word 23798, 0x3B5E # padding to push the following tokens past the scanner buffer  line 146
+    .word 23961, 0xD995 # padding to push the following tokens past the scanner buffer  line 147
+    .word 24124, 0x77CC # padding to push the following tokens past the scanner buffer  line 148
+    .word 24287, 0x1603 # padding to push the following tokens past the scanner buffer  line 149
+    .word 24450, 0xB43A # padding to push the following tokens past the scanner buffer  line 150
+    .word 24613, 0x5271 # padding to push the following tokens past the scanner buffer  line 151
+    .word 24776, 0xF0A8 # padding to push the following tokens past the scanner buffer  line 152
+    .word 24939, 0x8EDF # padding to push the following tokens past the scanner buffer  line 153
+    .word 25102, 0x2D16 # padding to push the following tokens past the scanner buffer  line 154
+    .word 25265, 0xCB4D # padding to push the following tokens past the scanner buffer  line 155
+    .word 25428, 0x6984 # padding to push the following tokens past the scanner buffer  line 156
+    .word 25591, 0x7BB # padding to push the following tokens past the scanner buffer  line 157
+    .word 25754, 0xA5F2 # padding to push the following tokens past the scanner buffer  line 158
+    .word 25917, 0x4429 # padding to push the following tokens past the scanner buffer  line 159
+    .word 26080, 0xE260 # padding to push the following tokens past the scanner buffer  line 160
+    .word 26243, 0x8097 # padding to push the following tokens past the scanner buffer  line 161
+    .word 26406, 0x1ECE # padding to push the following tokens past the scanner buffer  line 162
+    .word 26569, 0xBD05 # padding to push the following tokens past the scanner buffer  line 163
+    .word 26732, 0x5B3C # padding to push the following tokens past the scanner buffer  line 164
+    .word 26895, 0xF973 # padding to push the following tokens past the scanner buffer  line 165
+    .word 27058, 0x97AA # padding to push the following tokens past the scanner buffer  line 166
+    .word 27221, 0x35E1 # padding to push the following tokens past the scanner buffer  line 167
+    .word 27384, 0xD418 # padding to push the following tokens past the scanner buffer  line 168
+    .word 27547, 0x724F # padding to push the following tokens past the scanner buffer  line 169
+    .word 27710, 0x1086 # padding to push the following tokens past the scanner buffer  line 170
+    .word 27873, 0xAEBD # padding to push the following tokens past the scanner buffer  line 171
+    .word 28036, 0x4CF4 # padding to push the following tokens past the scanner buffer  line 172
+    .word 28199, 0xEB2B # padding to push the following tokens past the scanner buffer  line 173
+    .word 28362, 0x8962 # padding to push the following tokens past the scanner buffer  line 174
+    .word 28525, 0x2799 # padding to push the following tokens past the scanner buffer  line 175
+    .word 28688, 0xC5D0 # padding to push the following tokens past the scanner buffer  line 176
+    .word 28851, 0x6407 # padding to push the following tokens past the scanner buffer  line 177
+    .word 29014, 0x23E # padding to push the following tokens past the scanner buffer  line 178
+    .word 29177, 0xA075 # padding to push the following tokens past the scanner buffer  line 179
+    .word 29340, 0x3EAC # padding to push the following tokens past the scanner buffer  line 180
+    .word 29503, 0xDCE3 # padding to push the following tokens past the scanner buffer  line 181
+    .word 29666, 0x7B1A # padding to push the following tokens past the scanner buffer  line 182
+    .word 29829, 0x1951 # padding to push the following tokens past the scanner buffer  line 183
+    .word 29992, 0xB788 # padding to push the following tokens past the scanner buffer  line 184
+    .word 30155, 0x55BF # padding to push the following tokens past the scanner buffer  line 185
+    .word 30318, 0xF3F6 # padding to push the following tokens past the scanner buffer  line 186
+    .word 30481, 0x922D # padding to push the following tokens past the scanner buffer  line 187
+    .word 30644, 0x3064 # padding to push the following tokens past the scanner buffer  line 188
+    .word 30807, 0xCE9B # padding to push the following tokens past the scanner buffer  line 189
+    .word 30970, 0x6CD2 # padding to push the following tokens past the scanner buffer  line 190
+    .word 31133, 0xB09 # padding to push the following tokens past the scanner buffer  line 191
+    .word 31296, 0xA940 # padding to push the following tokens past the scanner buffer  line 192
+    .word 31459, 0x4777 # padding to push the following tokens past the scanner buffer  line 193
+    .word 31622, 0xE5AE # padding to push the following tokens past the scanner buffer  line 194
+    .word 31785, 0x83E5 # padding to push the following tokens past the scanner buffer  line 195
+    .word 31948, 0x221C # padding to push the following tokens past the scanner buffer  line 196
+    .word 32111, 0xC053 # padding to push the following tokens past the scanner buffer  line 197
+    .word 32274, 0x5E8A # padding to push the following tokens past the scanner buffer  line 198
+    .word 32437, 0xFCC1 # padding to push the following tokens past the scanner buffer  line 199
+    .word 32600, 0x9AF8 # padding to push the following tokens past the scanner buffer  line 200
+    .word 32763, 0x392F # padding to push the following tokens past the scanner buffer  line 201
+    .word 32926, 0xD766 # padding to push the following tokens past the scanner buffer  line 202
+    .word 33089, 0x759D # padding to push the following tokens past the scanner buffer  line 203
+    .word 33252, 0x13D4 # padding to push the following tokens past the scanner buffer  line 204
+    .word 33415, 0xB20B # padding to push the following tokens past the scanner buffer  line 205
+    .word 33578, 0x5042 # padding to push the following tokens past the scanner buffer  line 206
+    .word 33741, 0xEE79 # padding to push the following tokens past the scanner buffer  line 207
+    .word 33904, 0x8CB0 # padding to push the following tokens past the scanner buffer  line 208
+    .word 34067, 0x2AE7 # padding to push the following tokens past the scanner buffer  line 209
+    .word 34230, 0xC91E # padding to push the following tokens past the scanner buffer  line 210
+    .word 34393, 0x6755 # padding to push the following tokens past the scanner buffer  line 211
+    .word 34556, 0x58C # padding to push the following tokens past the scanner buffer  line 212
+    .word 34719, 0xA3C3 # padding to push the following tokens past the scanner buffer  line 213
+    .word 34882, 0x41FA # padding to push the following tokens past the scanner buffer  line 214
+    .word 35045, 0xE031 # padding to push the following tokens past the scanner buffer  line 215
+    .word 35208, 0x7E68 # padding to push the following tokens past the scanner buffer  line 216
+    .word 35371, 0x1C9F # padding to push the following tokens past the scanner buffer  line 217
+    .word 35534, 0xBAD6 # padding to push the following tokens past the scanner buffer  line 218
+    .word 35697, 0x590D # padding to push the following tokens past the scanner buffer  line 219
+    .word 35860, 0xF744 # padding to push the following tokens past the scanner buffer  line 220
+    .word 36023, 0x957B # padding to push the following tokens past the scanner buffer  line 221
+    .word 36186, 0x33B2 # padding to push the following tokens past the scanner buffer  line 222
+    .word 36349, 0xD1E9 # padding to push the following tokens past the scanner buffer  line 223
+    .word 36512, 0x7020 # padding to push the following tokens past the scanner buffer  line 224
+    .word 36675, 0xE57 # padding to push the following tokens past the scanner buffer  line 225
+    .word 36838, 0xAC8E # padding to push the following tokens past the scanner buffer  line 226
+    .word 37001, 0x4AC5 # padding to push the following tokens past the scanner buffer  line 227
+    .word 37164, 0xE8FC # padding to push the following tokens past the scanner buffer  line 228
+    .word 37327, 0x8733 # padding to push the following tokens past the scanner buffer  line 229
+    .word 37490, 0x256A # padding to push the following tokens past the scanner buffer  line 230
+    .word 37653, 0xC3A1 # padding to push the following tokens past the scanner buffer  line 231
+    .word 37816, 0x61D8 # padding to push the following tokens past the scanner buffer  line 232
+    .word 37979, 0xF # padding to push the following tokens past the scanner buffer  line 233
+    .word 38142, 0x9E46 # padding to push the following tokens past the scanner buffer  line 234
+    .word 38305, 0x3C7D # padding to push the following tokens past the scanner buffer  line 235
+    .word 38468, 0xDAB4 # padding to push the following tokens past the scanner buffer  line 236
+    .word 38631, 0x78EB # padding to push the following tokens past the scanner buffer  line 237
+    .word 38794, 0x1722 # padding to push the following tokens past the scanner buffer  line 238
+    .word 38957, 0xB559 # padding to push the following tokens past the scanner buffer  line 239
+    .word 39120, 0x5390 # padding to push the following tokens past the scanner buffer  line 240
+    .word 39283, 0xF1C7 # padding to push the following tokens past the scanner buffer  line 241
+    .word 39446, 0x8FFE # padding to push the following tokens past the scanner buffer  line 242
+    .word 39609, 0x2E35 # padding to push the following tokens past the scanner buffer  line 243
+    .word 39772, 0xCC6C # padding to push the following tokens past the scanner buffer  line 244
+    .word 39935, 0x6AA3 # padding to push the following tokens past the scanner buffer  line 245
+    .word 40098, 0x8DA # padding to push the following tokens past the scanner buffer  line 246
+    .word 40261, 0xA711 # padding to push the following tokens past the scanner buffer  line 247
+    .word 40424, 0x4548 # padding to push the following tokens past the scanner buffer  line 248
+    .word 40587, 0xE37F # padding to push the following tokens past the scanner buffer  line 249
+    .word 40750, 0x81B6 # padding to push the following tokens past the scanner buffer  line 250
+    .word 40913, 0x1FED # padding to push the following tokens past the scanner buffer  line 251
+    .word 41076, 0xBE24 # padding to push the following tokens past the scanner buffer  line 252
+    .word 41239, 0x5C5B # padding to push the following tokens past the scanner buffer  line 253
+    .word 41402, 0xFA92 # padding to push the following tokens past the scanner buffer  line 254
+    .word 41565, 0x98C9 # padding to push the following tokens past the scanner buffer  line 255
+    .word 41728, 0x3700 # padding to push the following tokens past the scanner buffer  line 256
+    .word 41891, 0xD537 # padding to push the following tokens past the scanner buffer  line 257
+    .word 42054, 0x736E # padding to push the following tokens past the scanner buffer  line 258
+    .word 42217, 0x11A5 # padding to push the following tokens past the scanner buffer  line 259
+    .word 42380, 0xAFDC # padding to push the following tokens past the scanner buffer  line 260
+    .word 42543, 0x4E13 # padding to push the following tokens past the scanner buffer  line 261
+    .word 42706, 0xEC4A # padding to push the following tokens past the scanner buffer  line 262
+    .word 42869, 0x8A81 # padding to push the following tokens past the scanner buffer  line 263
+    .word 43032, 0x28B8 # padding to push the following tokens past the scanner buffer  line 264
+    .word 43195, 0xC6EF # padding to push the following tokens past the scanner buffer  line 265
+    .word 43358, 0x6526 # padding to push the following tokens past the scanner buffer  line 266
+    .word 43521, 0x35D # padding to push the following tokens past the scanner buffer  line 267
+    .word 43684, 0xA194 # padding to push the following tokens past the scanner buffer  line 268
+    .word 43847, 0x3FCB # padding to push the following tokens past the scanner buffer  line 269
+    .word 44010, 0xDE02 # padding to push the following tokens past the scanner buffer  line 270
+    .word 44173, 0x7C39 # padding to push the following tokens past the scanner buffer  line 271
+    .word 44336, 0x1A70 # padding to push the following tokens past the scanner buffer  line 272
+    .word 44499, 0xB8A7 # padding to push the following tokens past the scanner buffer  line 273
+    .word 44662, 0x56DE # padding to push the following tokens past the scanner buffer  line 274
+    .word 44825, 0xF515 # padding to push the following tokens past the scanner buffer  line 275
+    .word 44988, 0x934C # padding to push the following tokens past the scanner buffer  line 276
+    .word 45151, 0x3183 # padding to push the following tokens past the scanner buffer  line 277
+    .word 45314, 0xCFBA # padding to push the following tokens past the scanner buffer  line 278
+    .word 45477, 0x6DF1 # padding to push the following tokens past the scanner buffer  line 279
+    .word 45640, 0xC28 # padding to push the following tokens past the scanner buffer  line 280
+    .word 45803, 0xAA5F # padding to push the following tokens past the scanner buffer  line 281
+    .word 45966, 0x4896 # padding to push the following tokens past the scanner buffer  line 282
+    .word 46129, 0xE6CD # padding to push the following tokens past the scanner buffer  line 283
+    .word 46292, 0x8504 # padding to push the following tokens past the scanner buffer  line 284
+    .word 46455, 0x233B # padding to push the following tokens past the scanner buffer  line 285
+    .word 46618, 0xC172 # padding to push the following tokens past the scanner buffer  line 286
+    .word 46781, 0x5FA9 # padding to push the following tokens past the scanner buffer  line 287
+    .word 46944, 0xFDE0 # padding to push the following tokens past the scanner buffer  line 288
+    .word 47107, 0x9C17 # padding to push the following tokens past the scanner buffer  line 289
+    .word 47270, 0x3A4E # padding to push the following tokens past the scanner buffer  line 290
+    .word 47433, 0xD885 # padding to push the following tokens past the scanner buffer  line 291
+    .word 47596, 0x76BC # padding to push the following tokens past the scanner buffer  line 292
+    .word 47759, 0x14F3 # padding to push the following tokens past the scanner buffer  line 293
+    .word 47922, 0xB32A # padding to push the following tokens past the scanner buffer  line 294
+    .word 48085, 0x5161 # padding to push the following tokens past the scanner buffer  line 295
+    .word 48248, 0xEF98 # padding to push the following tokens past the scanner buffer  line 296
+    .word 48411, 0x8DCF # padding to push the following tokens past the scanner buffer  line 297
+    .word 48574, 0x2C06 # padding to push the following tokens past the scanner buffer  line 298
+    .word 48737, 0xCA3D # padding to push the following tokens past the scanner buffer  line 299
+    .word 48900, 0x6874 # padding to push the following tokens past the scanner buffer  line 300
+    .word 49063, 0x6AB # padding to push the following tokens past the scanner buffer  line 301
+    .word 49226, 0xA4E2 # padding to push the following tokens past the scanner buffer  line 302
+    .word 49389, 0x4319 # padding to push the following tokens past the scanner buffer  line 303
+    .word 49552, 0xE150 # padding to push the following tokens past the scanner buffer  line 304
+    .word 49715, 0x7F87 # padding to push the following tokens past the scanner buffer  line 305
+    .word 49878, 0x1DBE # padding to push the following tokens past the scanner buffer  line 306
+    .word 50041, 0xBBF5 # padding to push the following tokens past the scanner buffer  line 307
+    .word 50204, 0x5A2C # padding to push the following tokens past the scanner buffer  line 308
+    .word 50367, 0xF863 # padding to push the following tokens past the scanner buffer  line 309
+    .word 50530, 0x969A # padding to push the following tokens past the scanner buffer  line 310
+    .word 50693, 0x34D1 # padding to push the following tokens past the scanner buffer  line 311
+    .word 50856, 0xD308 # padding to push the following tokens past the scanner buffer  line 312
+    .word 51019, 0x713F # padding to push the following tokens past the scanner buffer  line 313
+    .word 51182, 0xF76 # padding to push the following tokens past the scanner buffer  line 314
+    .word 51345, 0xADAD # padding to push the following tokens past the scanner buffer  line 315
+    .word 51508, 0x4BE4 # padding to push the following tokens past the scanner buffer  line 316
+    .word 51671, 0xEA1B # padding to push the following tokens past the scanner buffer  line 317
+    .word 51834, 0x8852 # padding to push the following tokens past the scanner buffer  line 318
+    .word 51997, 0x2689 # padding to push the following tokens past the scanner buffer  line 319
+    .word 52160, 0xC4C0 # padding to push the following tokens past the scanner buffer  line 320
+    .word 52323, 0x62F7 # padding to push the following tokens past the scanner buffer  line 321
+    .word 52486, 0x12E # padding to push the following tokens past the scanner buffer  line 322
+    .word 52649, 0x9F65 # padding to push the following tokens past the scanner buffer  line 323
+    .word 52812, 0x3D9C # padding to push the following tokens past the scanner buffer  line 324
+    .word 52975, 0xDBD3 # padding to push the following tokens past the scanner buffer  line 325
+    .word 53138, 0x7A0A # padding to push the following tokens past the scanner buffer  line 326
+    .word 53301, 0x1841 # padding to push the following tokens past the scanner buffer  line 327
+    .word 53464, 0xB678 # padding to push the following tokens past the scanner buffer  line 328
+    .word 53627, 0x54AF # padding to push the following tokens past the scanner buffer  line 329
+    .word 53790, 0xF2E6 # padding to push the following tokens past the scanner buffer  line 330
+    .word 53953, 0x911D # padding to push the following tokens past the scanner buffer  line 331
+    .word 54116, 0x2F54 # padding to push the following tokens past the scanner buffer  line 332
+    .word 54279, 0xCD8B # padding to push the following tokens past the scanner buffer  line 333
+    .word 54442, 0x6BC2 # padding to push the following tokens past the scanner buffer  line 334
+    .word 54605, 0x9F9 # padding to push the following tokens past the scanner buffer  line 335
+    .word 54768, 0xA830 # padding to push the following tokens past the scanner buffer  line 336
+    .word 54931, 0x4667 # padding to push the following tokens past the scanner buffer  line 337
+    .word 55094, 0xE49E # padding to push the following tokens past the scanner buffer  line 338
+    .word 55257, 0x82D5 # padding to push the following tokens past the scanner buffer  line 339
+    .word 55420, 0x210C # padding to push the following tokens past the scanner buffer  line 340
+    .word 55583, 0xBF43 # padding to push the following tokens past the scanner buffer  line 341
+    .word 55746, 0x5D7A # padding to push the following tokens past the scanner buffer  line 342
+    .word 55909, 0xFBB1 # padding to push the following tokens past the scanner buffer  line 343
+    .word 56072, 0x99E8 # padding to push the following tokens past the scanner buffer  line 344
+    .word 56235, 0x381F # padding to push the following tokens past the scanner buffer  line 345
+    .word 56398, 0xD656 # padding to push the following tokens past the scanner buffer  line 346
+    .word 56561, 0x748D # padding to push the following tokens past the scanner buffer  line 347
+    .word 56724, 0x12C4 # padding to push the following tokens past the scanner buffer  line 348
+    .word 56887, 0xB0FB # padding to push the following tokens past the scanner buffer  line 349
+    .word 57050, 0x4F32 # padding to push the following tokens past the scanner buffer  line 350
+    .word 57213, 0xED69 # padding to push the following tokens past the scanner buffer  line 351
+    .word 57376, 0x8BA0 # padding to push the following tokens past the scanner buffer  line 352
+    .word 57539, 0x29D7 # padding to push the following tokens past the scanner buffer  line 353
+    .word 57702, 0xC80E # padding to push the following tokens past the scanner buffer  line 354
+    .word 57865, 0x6645 # padding to push the following tokens past the scanner buffer  line 355
+    .word 58028, 0x47C # padding to push the following tokens past the scanner buffer  line 356
+    .word 58191, 0xA2B3 # padding to push the following tokens past the scanner buffer  line 357
+    .word 58354, 0x40EA # padding to push the following tokens past the scanner buffer  line 358
+    .word 58517, 0xDF21 # padding to push the following tokens past the scanner buffer  line 359
+    .word 58680, 0x7D58 # padding to push the following tokens past the scanner buffer  line 360
+    .word 58843, 0x1B8F # padding to push the following tokens past the scanner buffer  line 361
+    .word 59006, 0xB9C6 # padding to push the following tokens past the scanner buffer  line 362
+    .word 59169, 0x57FD # padding to push the following tokens past the scanner buffer  line 363
+    .word 59332, 0xF634 # padding to push the following tokens past the scanner buffer  line 364
+    .word 59495, 0x946B # padding to push the following tokens past the scanner buffer  line 365
+    .word 59658, 0x32A2 # padding to push the following tokens past the scanner buffer  line 366
+    .word 59821, 0xD0D9 # padding to push the following tokens past the scanner buffer  line 367
+    .word 59984, 0x6F10 # padding to push the following tokens past the scanner buffer  line 368
+    .word 60147, 0xD47 # padding to push the following tokens past the scanner buffer  line 369
+    .word 60310, 0xAB7E # padding to push the following tokens past the scanner buffer  line 370
+    .word 60473, 0x49B5 # padding to push the following tokens past the scanner buffer  line 371
+    .word 60636, 0xE7EC # padding to push the following tokens past the scanner buffer  line 372
+    .word 60799, 0x8623 # padding to push the following tokens past the scanner buffer  line 373
+    .word 60962, 0x245A # padding to push the following tokens past the scanner buffer  line 374
+    .word 61125, 0xC291 # padding to push the following tokens past the scanner buffer  line 375
+    .word 61288, 0x60C8 # padding to push the following tokens past the scanner buffer  line 376
+    .word 61451, 0xFEFF # padding to push the following tokens past the scanner buffer  line 377
+    .word 61614, 0x9D36 # padding to push the following tokens past the scanner buffer  line 378
+    .word 61777, 0x3B6D # padding to push the following tokens past the scanner buffer  line 379
+    .word 61940, 0xD9A4 # padding to push the following tokens past the scanner buffer  line 380
+    .word 62103, 0x77DB # padding to push the following tokens past the scanner buffer  line 381
+    .word 62266, 0x1612 # padding to push the following tokens past the scanner buffer  line 382
+    .word 62429, 0xB449 # padding to push the following tokens past the scanner buffer  line 383
+    .word 62592, 0x5280 # padding to push the following tokens past the scanner buffer  line 384
+    .word 62755, 0xF0B7 # padding to push the following tokens past the scanner buffer  line 385
+    .word 62918, 0x8EEE # padding to push the following tokens past the scanner buffer  line 386
+    .word 63081, 0x2D25 # padding to push the following tokens past the scanner buffer  line 387
+    .word 63244, 0xCB5C # padding to push the following tokens past the scanner buffer  line 388
+    .word 63407, 0x6993 # padding to push the following tokens past the scanner buffer  line 389
+    .word 63570, 0x7CA # padding to push the following tokens past the scanner buffer  line 390
+    .word 63733, 0xA601 # padding to push the following tokens past the scanner buffer  line 391
+    .word 63896, 0x4438 # padding to push the following tokens past the scanner buffer  line 392
+    .word 64059, 0xE26F # padding to push the following tokens past the scanner buffer  line 393
+    .word 64222, 0x80A6 # padding to push the following tokens past the scanner buffer  line 394
+    .word 64385, 0x1EDD # padding to push the following tokens past the scanner buffer  line 395
+    .word 64548, 0xBD14 # padding to push the following tokens past the scanner buffer  line 396
+    .word 64711, 0x5B4B # padding to push the following tokens past the scanner buffer  line 397
+    .word 64874, 0xF982 # padding to push the following tokens past the scanner buffer  line 398
+    .word 65037, 0x97B9 # padding to push the following tokens past the scanner buffer  line 399
+.end
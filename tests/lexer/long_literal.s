@@ -0,0 +1,308 @@
+# Literal bounds and their text in diagnostics, after enough input to
+# refill the scanner buffer several times
+.section data
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 0
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 1
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 2
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 3
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 4
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 5
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 6
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 7
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 8
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 9
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 10
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 11
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 12
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 13
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 14
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 15
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 16
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 17
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 18
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 19
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 20
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 21
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 22
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 23
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 24
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 25
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 26
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 27
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 28
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 29
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 30
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 31
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 32
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 33
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 34
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 35
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 36
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 37
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 38
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 39
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 40
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 41
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 42
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 43
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 44
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 45
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 46
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 47
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 48
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 49
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 50
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 51
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 52
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 53
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 54
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 55
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 56
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 57
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 58
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 59
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 60
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 61
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 62
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 63
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 64
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 65
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 66
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 67
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 68
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 69
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 70
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 71
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 72
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 73
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 74
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 75
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 76
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 77
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 78
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 79
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 80
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 81
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 82
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 83
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 84
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 85
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 86
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 87
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 88
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 89
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 90
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 91
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 92
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 93
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 94
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 95
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 96
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 97
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 98
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 99
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 100
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 101
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 102
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 103
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 104
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 105
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 106
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 107
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 108
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 109
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 110
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 111
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 112
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 113
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 114
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 115
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 116
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 117
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 118
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 119
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 120
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 121
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 122
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 123
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 124
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 125
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 126
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 127
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 128
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 129
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 130
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 131
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 132
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 133
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 134
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 135
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 136
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 137
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 138
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 139
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 140
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 141
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 142
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 143
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 144
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 145
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 146
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 147
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 148
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 149
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 150
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 151
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 152
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 153
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 154
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 155
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 156
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 157
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 158
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 159
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 160
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 161
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 162
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 163
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 164
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 165
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 166
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 167
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 168
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 169
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 170
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 171
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 172
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 173
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 174
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 175
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 176
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 177
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 178
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 179
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 180
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 181
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 182
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 183
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 184
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 185
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 186
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 187
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 188
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 189
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 190
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 191
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 192
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 193
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 194
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 195
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 196
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 197
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 198
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 199
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 200
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 201
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 202
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 203
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 204
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 205
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 206
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 207
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 208
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 209
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 210
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 211
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 212
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 213
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 214
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 215
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 216
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 217
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 218
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 219
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 220
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 221
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 222
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 223
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 224
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 225
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 226
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 227
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 228
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 229
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 230
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 231
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 232
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 233
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 234
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 235
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 236
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 237
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 238
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 239
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 240
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 241
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 242
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 243
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 244
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 245
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 246
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 247
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 248
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 249
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 250
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 251
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 252
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 253
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 254
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 255
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 256
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 257
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 258
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 259
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 260
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 261
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 262
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 263
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 264
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 265
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 266
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 267
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 268
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 269
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 270
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 271
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 272
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 273
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 274
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 275
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 276
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 277
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 278
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 279
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 280
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 281
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 282
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 283
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 284
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 285
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 286
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 287
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 288
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 289
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 290
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 291
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 292
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 293
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 294
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 295
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 296
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 297
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 298
+    .word 65535, 0xFFFF, 0 # padding to push the following tokens past the scanner buffer  line 299
+    .word 65536
+    .word 0x10000
+    .word 000000000000000000065535
+    .word 99999999999999999999
+.end
@@ -0,0 +1,15 @@
+# run:
+# A macro use with the wrong number of arguments is an error; the line is
+# skipped and assembly goes on
+.macro two a, b
+add a, b
+.endm
+.macro none
+halt
+.endm
+.section code
+two r1
+two r1, r2, r3
+none r1
+two r1, r2
+.end
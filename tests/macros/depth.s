@@ -0,0 +1,10 @@
+# run:
+# A macro expanding itself stops at MAX_EXPANSION_DEPTH (64); only the
+# innermost expansions are listed
+.macro forever
+.word 1
+forever
+.endm
+.section data
+forever
+.end
@@ -0,0 +1,17 @@
+# run:
+# Errors inside an expansion name where it was expanded, innermost first
+.macro bad
+ldr r1, r2, r3
+.endm
+.macro outer
+.rept 1
+bad
+.endr
+.endm
+.section code
+bad
+outer
+.rept 2
+str r1, $1
+.endr
+.end
@@ -0,0 +1,9 @@
+# run:
+# A .macro without its .endm is reported at the .macro
+.section data
+.word 1
+.macro m
+.word 2
+.rept 2
+.endr
+.end
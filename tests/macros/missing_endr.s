@@ -0,0 +1,7 @@
+# run:
+# A .rept without its .endr is reported at the .rept
+.section data
+.word 1
+.rept 2
+.word 2
+.end
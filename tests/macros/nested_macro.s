@@ -0,0 +1,23 @@
+# run:
+# run: --single-pass
+# A macro calling another macro, and a .rept inside a macro body
+.macro save r
+push r
+.endm
+.macro restore r
+pop r
+.endm
+.macro wrap a, b
+save a
+save b
+.rept 2
+add a, b
+.endr
+restore b
+restore a
+.endm
+.section code
+wrap r1, r2
+wrap r3, r4
+halt
+.end
@@ -0,0 +1,14 @@
+# run:
+# run: --single-pass
+# Nested .rept: the inner body is repeated for each outer repetition
+.section data
+.rept 2
+.word 0xAA
+.rept 3
+.word 1
+.endr
+.endr
+.rept 0
+.word 0xDEAD                # never assembled
+.endr
+.end
@@ -0,0 +1,10 @@
+# run:
+# run: -O
+# .equ aliases of a label that fall outside its section (regression: they
+# were marked as labels, past the end of the label table)
+.global far, far2
+.section code
+start: halt
+.equ far, start - 5
+.equ far2, start + 0x4000
+.end
@@ -0,0 +1,20 @@
+# run:
+# run: -O
+# Jumps and calls to an unconditional jump go to its target, over
+# several hops; conditional jumps are not followed
+.extern ext
+.section code
+start:
+    call a
+    jeq a
+    jmp %a                  # PC relative, followed only to PC relative jumps
+    jgt b
+a:  jmp b
+b:  jmp c
+c:  jmp ext
+d:  jeq ext
+    jmp d                   # d is conditional, not threaded
+e:  jmp %f
+f:  jmp %start
+    jmp %e
+.end
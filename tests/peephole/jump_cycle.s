@@ -0,0 +1,14 @@
+# run:
+# run: -O
+# Jump cycles end the threading without looping
+.section code
+start:
+    jmp a
+a:  jmp b
+b:  jmp a
+self: jmp self
+    call self
+    jmp %c
+c:  jmp %d
+d:  jmp %c
+.end
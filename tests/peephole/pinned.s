@@ -0,0 +1,11 @@
+# run:
+# run: -O
+# A label used with an offset pins its section: nothing is removed
+.section code
+start:
+    push r1
+    pop r1
+    halt
+.section data
+.word start + 6
+.end
@@ -0,0 +1,21 @@
+# run:
+# run: -O
+# push rX followed by pop rX is removed, unless a label is between them;
+# labels after a removed pair move down
+.global after
+.section code
+start:
+    push r1
+    pop r1                  # removed
+    push r2
+mid: pop r2                 # kept, mid can be jumped to
+    push r3
+    pop r4                  # kept, different registers
+    push r5
+    pop r5                  # removed
+after:
+    jmp after
+    jmp mid
+.section data
+.word after, mid
+.end
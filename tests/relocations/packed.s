@@ -0,0 +1,26 @@
+# Packed relocation sections (--packed-rel): entries sorted by offset, with
+# delta encoded offsets and symbol ids, decode back to the unpacked list
+# run:
+# run: --packed-rel
+# run: --packed-rel --single-pass
+.extern e0, e1, e2, e3
+.global g
+.section code
+g:
+    ldr r0, e3              # symbol ids go down as well as up
+    ldr r1, e0
+    call e2
+    jmp data_end            # label of another section
+    .skip 300               # offset delta over 127, two varint bytes
+    ldr r2, %e1             # PC relative
+    str r3, later           # forward reference (fixup in single pass mode)
+    jmp %local              # same section: no relocation
+local:
+    halt
+later:
+    .word 0
+.section data
+    .word later + 2, e1, g, e0, data_end
+data_end:
+    .word 0
+.end
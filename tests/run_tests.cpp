@@ -0,0 +1,458 @@
+// Fixture tests: every .s file under the tests directory is assembled and
+// its diagnostics and a dump of the object file are compared with the
+// .expected file next to it.
+//
+//   run_tests <tests dir> <output dir> [--update]
+//
+// Comment lines at the top of a fixture configure it:
+//   # run: <options>   one run per line, none means a single run without
+//                      options (-O, --single-pass, --packed-rel, --zero-fill,
+//                      and --memory: the source is passed as bytes, as the
+//                      server does with standard input)
+//   # same-object: <fixture>   each run must also give the object of
+//                      that fixture assembled with the same options
+// Runs with --packed-rel are also checked against the relocations of the
+// object assembled without it, runs with --zero-fill against its data
+// sections. --update writes the .expected files instead of comparing them.
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "assembler.hpp"
+
+namespace fs = std::filesystem;
+
+namespace
+{
+
+struct Run
+{
+    std::string options; // as written in the fixture
+    AssemblerOptions assemblerOptions;
+    bool memory = false; // source passed in memory, not as a file
+};
+
+struct Fixture
+{
+    std::string name; // path relative to the tests directory
+    std::vector<Run> runs;
+    std::string sameObject; // fixture with the same object, empty if none
+};
+
+std::string readFile(const std::string& filename)
+{
+    std::ifstream in(filename, std::ios::binary);
+    std::ostringstream contents;
+    contents << in.rdbuf();
+    return contents.str();
+}
+
+bool parseOptions(const std::string& text, Run &run)
+{
+    AssemblerOptions &options = run.assemblerOptions;
+    std::istringstream in(text);
+    std::string option;
+    while (in >> option) {
+        if (option == "--memory")
+            run.memory = true;
+        else if (option == "-O")
+            options.optimize = true;
+        else if (option == "--single-pass")
+            options.singlePass = true;
+        else if (option == "--packed-rel")
+            options.packedRelocations = true;
+        else if (option == "--zero-fill")
+            options.zeroFill = true;
+        else
+            return false;
+    }
+    return true;
+}
+
+bool loadFixture(const std::string& name, Fixture &fixture, std::string &error)
+{
+    static const std::string RUN = "# run:", SAME_OBJECT = "# same-object:";
+
+    fixture.name = name;
+    std::istringstream in(readFile(name));
+    std::string line;
+    while (std::getline(in, line) && line.compare(0, 1, "#") == 0) {
+        if (line.compare(0, SAME_OBJECT.size(), SAME_OBJECT) == 0) {
+            std::istringstream(line.substr(SAME_OBJECT.size())) >> fixture.sameObject;
+            continue;
+        }
+        if (line.compare(0, RUN.size(), RUN) != 0)
+            continue;
+        Run run;
+        run.options = line.substr(RUN.size());
+        run.options.erase(0, run.options.find_first_not_of(' '));
+        if (!parseOptions(run.options, run)) {
+            error = "unknown option in: " + line;
+            return false;
+        }
+        fixture.runs.push_back(run);
+    }
+    if (fixture.runs.empty())
+        fixture.runs.push_back(Run());
+    return true;
+}
+
+// Reads the object format back (see obj.hpp, section.hpp, symbol.hpp)
+class ObjectReader
+{
+public:
+    explicit ObjectReader(const std::string& object) : object_(object) {}
+
+    bool read(std::string &error)
+    {
+        if (!get(0, header_) || header_.magic != OBJ_MAGIC_BYTES) {
+            error = "bad object header";
+            return false;
+        }
+        for (uint i = 0; i < header_.shtSize; ++i) {
+            SectionEntry &entry = sections_.emplace_back();
+            if (!get(header_.shtOffset + i * sizeof(SectionEntry), entry)
+                || entry.dataOffset + entry.storedSize() > object_.size()) {
+                error = "bad section entry " + std::to_string(i);
+                return false;
+            }
+        }
+        if (header_.strEntryId >= sections_.size()) {
+            error = "bad names section id";
+            return false;
+        }
+        for (uint i = 0; i < sections_.size(); ++i)
+            if (sections_[i].type == ST_SYM_TAB)
+                symTab_ = i;
+        return true;
+    }
+
+    const std::vector<SectionEntry>& sections() const { return sections_; }
+
+    // Stored bytes of a section
+    std::string_view data(uint id) const
+    {
+        return std::string_view(object_).substr(sections_[id].dataOffset, sections_[id].storedSize());
+    }
+
+    std::string name(uint nameOffset) const
+    {
+        std::string_view names = data(header_.strEntryId);
+        if (nameOffset >= names.size())
+            return "<bad name>";
+        return std::string(names.substr(nameOffset, names.find('\0', nameOffset) - nameOffset));
+    }
+
+    bool symbol(uint id, SymbolEntry &entry) const
+    {
+        return symTab_ && (id + 1) * sizeof(SymbolEntry) <= data(symTab_).size()
+            && get(sections_[symTab_].dataOffset + id * sizeof(SymbolEntry), entry);
+    }
+
+    std::string symbolName(uint id) const
+    {
+        SymbolEntry entry;
+        return symbol(id, entry) ? name(entry.nameOffset) : "<bad symbol " + std::to_string(id) + ">";
+    }
+
+    // Entries of a relocation section, packed ones decoded (false if malformed)
+    bool relocations(uint id, std::vector<RelEntry> &entries) const
+    {
+        std::string_view rel = data(id);
+        if (!(sections_[id].flags & SF_PACKED_REL)) {
+            for (std::size_t pos = 0; pos + sizeof(RelEntry) <= rel.size(); pos += sizeof(RelEntry)) {
+                RelEntry &entry = entries.emplace_back(RT_SYM_16, 0, 0);
+                std::memcpy(&entry, rel.data() + pos, sizeof(RelEntry));
+            }
+            return rel.size() % sizeof(RelEntry) == 0;
+        }
+
+        // Unsigned LEB128
+        std::size_t pos = 0;
+        auto varint = [&rel, &pos](uint &value) {
+            value = 0;
+            for (uint shift = 0; pos < rel.size() && shift < 32; shift += 7) {
+                ubyte byte = rel[pos++];
+                value |= (uint)(byte & 0x7F) << shift;
+                if (!(byte & 0x80))
+                    return true;
+            }
+            return false;
+        };
+        uint offset = 0, symbolId = 0;
+        while (pos < rel.size()) {
+            uint first, second;
+            if (!varint(first) || !varint(second))
+                return false;
+            offset += first >> 2;
+            symbolId += (second >> 1) ^ (0 - (second & 1)); // zigzag
+            entries.emplace_back((RelType)(first & 3), (ushort)offset, (ushort)symbolId);
+        }
+        return true;
+    }
+
+private:
+    template<typename T>
+    bool get(std::size_t offset, T &value) const
+    {
+        if (offset + sizeof(T) > object_.size())
+            return false;
+        std::memcpy(&value, object_.data() + offset, sizeof(T));
+        return true;
+    }
+
+    const std::string& object_;
+    ObjHeader header_;
+    std::vector<SectionEntry> sections_;
+    uint symTab_ = 0;
+};
+
+std::string hex(uint value, int digits)
+{
+    static const char DIGITS[] = "0123456789abcdef";
+    std::string text(digits, '0');
+    for (int i = digits - 1; i >= 0; --i, value >>= 4)
+        text[i] = DIGITS[value & 0xF];
+    return text;
+}
+
+void dumpObject(std::ostream& out, const std::string& object)
+{
+    static const char *const TYPE_NAMES[] = { "none", "data", "rel", "str", "symtab" };
+    static const char *const REL_NAMES[] = { "sym16", "sym16_be", "pc" };
+    static const char *const BIND_NAMES[] = { "local", "global" };
+    static const char *const SYMBOL_TYPE_NAMES[] = { "undef", "abs", "label", "section" };
+
+    ObjectReader reader(object);
+    std::string error;
+    if (!reader.read(error)) {
+        out << "object: " << error << "\n";
+        return;
+    }
+
+    const std::vector<SectionEntry>& sections = reader.sections();
+    // Offsets are part of the output: a layout change needs a version bump
+    out << "object: " << sections.size() - 1 << " sections\n";
+    for (uint id = 1; id < sections.size(); ++id) {
+        const SectionEntry &entry = sections[id];
+        out << "section " << id << " " << reader.name(entry.nameOffset) << " "
+            << (entry.type <= ST_SYM_TAB ? TYPE_NAMES[entry.type] : "?") << " size " << entry.size
+            << " offset " << entry.dataOffset;
+        if (entry.flags & SF_PACKED_REL)
+            out << " packed";
+        if (entry.flags & SF_ZERO_FILL)
+            out << " zero-fill, stored " << entry.fileSize;
+        out << "\n";
+
+        std::string_view data = reader.data(id);
+        if (entry.type == ST_DATA) {
+            for (std::size_t pos = 0; pos < data.size(); pos += 16) {
+                out << "  " << hex(pos, 4) << ":";
+                for (std::size_t i = pos; i < data.size() && i < pos + 16; ++i)
+                    out << " " << hex((ubyte)data[i], 2);
+                out << "\n";
+            }
+        } else if (entry.type == ST_REL) {
+            std::vector<RelEntry> entries;
+            bool valid = reader.relocations(id, entries);
+            for (const RelEntry &rel : entries)
+                out << "  " << (rel.type <= RT_PC ? REL_NAMES[rel.type] : "?") << " " << hex(rel.offset, 4)
+                    << " " << reader.symbolName(rel.symbolId) << "\n";
+            if (!valid)
+                out << "  <malformed entry>\n";
+        } else if (entry.type == ST_SYM_TAB) {
+            SymbolEntry symbol;
+            for (uint i = 1; reader.symbol(i, symbol); ++i)
+                out << "  " << i << " " << reader.name(symbol.nameOffset) << " "
+                    << BIND_NAMES[symbol.bind & 1] << " " << SYMBOL_TYPE_NAMES[symbol.type & 3]
+                    << " value " << hex(symbol.value, 4) << " section " << symbol.sectionEntryId << "\n";
+        }
+    }
+}
+
+struct RunResult
+{
+    int res;
+    std::string diagnostics; // output file name replaced by <output>
+    std::string object; // empty on errors
+};
+
+RunResult assemble(const std::string& name, const AssemblerOptions& options, bool memory,
+                   const std::string& outFilename)
+{
+    std::ostringstream diagnostics;
+    Assembler assembler(options);
+    assembler.setDiagnostics(diagnostics);
+    std::remove(outFilename.c_str());
+
+    RunResult result;
+    result.res = memory ? assembler.run(readFile(name), name, outFilename) : assembler.run(name, outFilename);
+    if (result.res == AE_OK)
+        result.object = readFile(outFilename);
+
+    // The output file name depends on where the tests run
+    result.diagnostics = diagnostics.str();
+    for (std::size_t pos; (pos = result.diagnostics.find(outFilename)) != std::string::npos; )
+        result.diagnostics.replace(pos, outFilename.size(), "<output>");
+    return result;
+}
+
+// Packed relocation sections hold the entries of the unpacked object,
+// sorted by offset
+void checkPackedRelocations(const std::string& packed, const std::string& unpacked,
+                            std::vector<std::string> &failures)
+{
+    ObjectReader packedReader(packed), unpackedReader(unpacked);
+    std::string error;
+    if (!packedReader.read(error) || !unpackedReader.read(error)
+        || packedReader.sections().size() != unpackedReader.sections().size()) {
+        failures.push_back("packed relocations: can't compare with the unpacked object " + error);
+        return;
+    }
+
+    for (uint id = 1; id < packedReader.sections().size(); ++id) {
+        if (unpackedReader.sections()[id].type != ST_REL)
+            continue;
+        std::vector<RelEntry> entries, expected;
+        if (!(packedReader.sections()[id].flags & SF_PACKED_REL) || !packedReader.relocations(id, entries)
+            || !unpackedReader.relocations(id, expected)) {
+            failures.push_back("packed relocations: section " + std::to_string(id) + " is not packed");
+            continue;
+        }
+        std::stable_sort(expected.begin(), expected.end(), [](const RelEntry &a, const RelEntry &b) {
+            return a.offset < b.offset;
+        });
+        bool same = entries.size() == expected.size();
+        for (std::size_t i = 0; same && i < entries.size(); ++i)
+            same = entries[i].type == expected[i].type && entries[i].offset == expected[i].offset
+                && entries[i].symbolId == expected[i].symbolId;
+        if (!same)
+            failures.push_back("packed relocations: section " + std::to_string(id)
+                               + " doesn't decode to the unpacked entries");
+    }
+}
+
+// Zero-fill data sections store fewer bytes than their size, the ones of
+// the object assembled without --zero-fill, whose remaining bytes are zero
+void checkZeroFill(const std::string& zeroFill, const std::string& full, std::vector<std::string> &failures)
+{
+    ObjectReader zeroFillReader(zeroFill), fullReader(full);
+    std::string error;
+    if (!zeroFillReader.read(error) || !fullReader.read(error)
+        || zeroFillReader.sections().size() != fullReader.sections().size()) {
+        failures.push_back("zero-fill: can't compare with the object without --zero-fill " + error);
+        return;
+    }
+
+    for (uint id = 1; id < zeroFillReader.sections().size(); ++id) {
+        const SectionEntry &entry = zeroFillReader.sections()[id];
+        if (entry.type != ST_DATA)
+            continue;
+        std::string_view stored = zeroFillReader.data(id), data = fullReader.data(id);
+        std::string section = "zero-fill: section " + std::to_string(id);
+        if (entry.size != fullReader.sections()[id].size)
+            failures.push_back(section + " changed size");
+        else if (!(entry.flags & SF_ZERO_FILL) && stored != data)
+            failures.push_back(section + " changed");
+        else if ((entry.flags & SF_ZERO_FILL) && !(entry.fileSize < entry.size))
+            failures.push_back(section + " fileSize isn't less than its size");
+        else if (data.substr(0, stored.size()) != stored
+                 || data.find_first_not_of('\0', stored.size()) != std::string_view::npos)
+            failures.push_back(section + " stored bytes differ or non-zero bytes were dropped");
+    }
+}
+
+// Output of one run as written in the .expected file, checks of the
+// object against runs without some options add to failures
+std::string runFixture(const Fixture& fixture, const Run& run, const std::string& outFilename,
+                       std::vector<std::string> &failures)
+{
+    RunResult result = assemble(fixture.name, run.assemblerOptions, run.memory, outFilename);
+
+    std::ostringstream out;
+    out << "== run" << (run.options.empty() ? "" : ": ") << run.options << "\n";
+    out << "status " << result.res << "\n";
+    out << result.diagnostics;
+    if (result.res != AE_OK)
+        return out.str();
+    dumpObject(out, result.object);
+
+    if (!fixture.sameObject.empty()
+        && assemble(fixture.sameObject, run.assemblerOptions, run.memory, outFilename).object != result.object)
+        failures.push_back("object differs from " + fixture.sameObject);
+    if (run.assemblerOptions.packedRelocations) {
+        AssemblerOptions options = run.assemblerOptions;
+        options.packedRelocations = false;
+        checkPackedRelocations(result.object, assemble(fixture.name, options, run.memory, outFilename).object,
+                               failures);
+    }
+    if (run.assemblerOptions.zeroFill) {
+        AssemblerOptions options = run.assemblerOptions;
+        options.zeroFill = false;
+        checkZeroFill(result.object, assemble(fixture.name, options, run.memory, outFilename).object, failures);
+    }
+    return out.str();
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 3) {
+        std::cerr << "usage: run_tests <tests dir> <output dir> [--update]\n";
+        return 2;
+    }
+    bool update = argc > 3 && argv[3] == std::string("--update");
+    fs::path outDir = fs::absolute(argv[2]);
+    fs::create_directories(outDir);
+
+    // Fixtures are named relative to the tests directory in diagnostics
+    fs::current_path(argv[1]);
+    std::vector<std::string> names;
+    for (const fs::directory_entry& entry : fs::recursive_directory_iterator("."))
+        if (entry.is_regular_file() && entry.path().extension() == ".s")
+            names.push_back(entry.path().lexically_relative(".").string());
+    std::sort(names.begin(), names.end());
+
+    unsigned failed = 0;
+    for (const std::string& name : names) {
+        Fixture fixture;
+        std::string error;
+        if (!loadFixture(name, fixture, error)) {
+            std::cout << "FAIL " << name << ": " << error << "\n";
+            ++failed;
+            continue;
+        }
+
+        std::string output;
+        std::vector<std::string> failures;
+        for (const Run& run : fixture.runs)
+            output += runFixture(fixture, run, (outDir / "test.o").string(), failures);
+        for (const std::string& failure : failures)
+            std::cout << "FAIL " << name << ": " << failure << "\n";
+        failed += !failures.empty();
+
+        std::string expectedName = fs::path(name).replace_extension(".expected").string();
+        if (update) {
+            std::ofstream(expectedName, std::ios::binary) << output;
+            continue;
+        }
+        if (failures.empty() && (!fs::exists(expectedName) || readFile(expectedName) != output)) {
+            std::string actualName = fs::path(name).replace_extension(".actual").string();
+            std::replace(actualName.begin(), actualName.end(), '/', '_');
+            std::ofstream(outDir / actualName, std::ios::binary) << output;
+            std::cout << "FAIL " << name << ": output differs from " << expectedName << "\n";
+            ++failed;
+        }
+    }
+
+    std::cout << names.size() - failed << "/" << names.size() << " fixtures passed\n";
+    return failed ? 1 : 0;
+}
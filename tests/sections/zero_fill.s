@@ -0,0 +1,20 @@
+# Trailing .skip bytes of data sections are not stored with --zero-fill
+# run:
+# run: --zero-fill
+# run: --zero-fill --single-pass
+.global buffer, stack
+.section data
+    .word 1, 2
+buffer:
+    .skip 256               # trailing: not stored
+.section stack
+stack:
+    .skip 64                # only .skip: nothing stored
+.section code
+    ldr r0, $1
+    .skip 4                 # followed by code: stored
+    str r0, buffer
+    .skip 0x100
+.section full
+    .word 0xFFFF
+.end